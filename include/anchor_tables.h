@@ -0,0 +1,331 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	// anchors which other holidays are made from (or which are holidays themselves), looked up rather than calculated
+	// (generated from the formulas in annual_holidays.h and equinoxes_solstices.h, which are used outside of the tables
+	// and which the tables are checked against - Easter at compile time, equinoxes and solstices by the tests as std::cos is not constexpr)
+
+	constexpr auto _anchor_tables_from = std::chrono::year{ 1583 }; // the first full year of the Gregorian calendar
+	constexpr auto _anchor_tables_until = std::chrono::year{ 2400 };
+
+
+	[[nodiscard]] constexpr auto _in_anchor_tables(const std::chrono::year& y) noexcept -> bool
+	{
+		return _anchor_tables_from <= y && y <= _anchor_tables_until;
+	}
+
+	[[nodiscard]] constexpr auto _anchor_table_index(const std::chrono::year& y) noexcept -> std::size_t
+	{
+		return static_cast<std::size_t>((y - _anchor_tables_from).count());
+	}
+
+	// days of March go on into April and May (32 is 1 April)
+	[[nodiscard]] constexpr auto _from_day_of_March(const std::chrono::year& y, const unsigned d) noexcept -> std::chrono::year_month_day
+	{
+		if (d <= 31u)
+			return { y, std::chrono::March, std::chrono::day{ d } };
+		else if (d <= 61u)
+			return { y, std::chrono::April, std::chrono::day{ d - 31u } };
+		else
+			return { y, std::chrono::May, std::chrono::day{ d - 61u } };
+	}
+
+
+	// Gregorian
+	inline constexpr auto _Easter_days_of_March = std::array<std::uint8_t, 818uz>{
+		41, 32, 52, 37, 29, 48, 33, 53, 45, 29, 49, 41, 26, 45, 37, 22, 42, 33, 53, 38,
+		30, 49, 41, 26, 46, 37, 50, 42, 34, 53, 38, 30, 50, 34, 26, 46, 31, 50, 42, 27,
+		47, 38, 30, 43, 35, 54, 46, 31, 51, 42, 27, 47, 39, 23, 43, 35, 55, 39, 31, 51,
+		36, 27, 47, 32, 52, 43, 35, 48, 40, 31, 44, 36, 28, 47, 32, 52, 44, 28, 48, 40,
+		25, 44, 36, 56, 41, 32, 52, 37, 29, 48, 33, 25, 45, 36, 49, 41, 33, 52, 37, 29,
+		49, 33, 53, 45, 30, 49, 41, 26, 46, 37, 22, 42, 34, 53, 38, 30, 50, 42, 27, 47,
+		39, 23, 43, 35, 55, 39, 31, 51, 36, 27, 47, 32, 52, 43, 28, 48, 40, 31, 44, 36,
+		28, 47, 32, 52, 44, 28, 48, 40, 25, 44, 36, 56, 41, 32, 52, 37, 29, 48, 33, 25,
+		45, 36, 49, 41, 33, 45, 37, 29, 42, 33, 53, 45, 30, 49, 41, 26, 46, 37, 22, 42,
+		34, 53, 38, 30, 50, 34, 26, 46, 31, 50, 42, 34, 47, 38, 30, 50, 35, 26, 46, 31,
+		51, 42, 27, 47, 39, 23, 43, 35, 55, 39, 31, 51, 36, 27, 47, 39, 24, 44, 36, 49,
+		41, 32, 45, 37, 29, 48, 33, 53, 45, 29, 49, 41, 26, 45, 37, 22, 42, 33, 53, 38,
+		30, 49, 34, 26, 46, 37, 50, 42, 34, 53, 38, 30, 50, 34, 26, 46, 31, 50, 42, 27,
+		47, 38, 23, 43, 35, 54, 39, 31, 51, 42, 27, 47, 39, 23, 43, 35, 55, 39, 31, 51,
+		36, 27, 47, 32, 52, 43, 28, 48, 40, 31, 44, 36, 28, 47, 32, 52, 44, 28, 48, 40,
+		25, 44, 36, 56, 41, 32, 52, 37, 29, 48, 33, 25, 45, 36, 49, 41, 33, 46, 38, 30,
+		43, 34, 54, 46, 31, 50, 42, 27, 47, 38, 23, 43, 35, 54, 39, 31, 51, 35, 27, 47,
+		32, 51, 43, 35, 48, 39, 31, 51, 36, 27, 47, 32, 52, 43, 28, 48, 40, 24, 44, 36,
+		56, 40, 32, 52, 37, 28, 48, 40, 25, 44, 36, 49, 41, 32, 52, 37, 29, 48, 33, 53,
+		45, 29, 49, 41, 26, 45, 37, 29, 42, 33, 53, 45, 30, 49, 41, 26, 46, 37, 50, 42,
+		34, 53, 38, 30, 50, 34, 26, 46, 31, 50, 42, 34, 47, 38, 30, 43, 35, 54, 46, 31,
+		51, 42, 27, 47, 39, 23, 43, 35, 55, 39, 31, 51, 36, 27, 47, 32, 52, 43, 35, 48,
+		40, 31, 51, 36, 28, 47, 32, 52, 44, 28, 48, 40, 25, 44, 36, 56, 41, 32, 52, 37,
+		29, 48, 40, 25, 45, 36, 49, 41, 33, 52, 37, 29, 49, 33, 53, 45, 30, 49, 41, 26,
+		46, 37, 29, 42, 34, 53, 45, 30, 50, 41, 26, 46, 38, 50, 42, 34, 54, 38, 30, 50,
+		35, 26, 46, 31, 51, 42, 34, 47, 39, 30, 43, 35, 55, 46, 31, 51, 43, 28, 48, 40,
+		25, 44, 36, 49, 41, 32, 52, 37, 29, 48, 33, 53, 45, 29, 49, 41, 26, 45, 37, 29,
+		42, 33, 53, 45, 30, 49, 41, 26, 46, 37, 50, 42, 34, 53, 38, 30, 50, 34, 26, 46,
+		31, 50, 42, 34, 47, 38, 30, 43, 35, 54, 46, 31, 51, 42, 27, 47, 39, 23, 43, 35,
+		55, 39, 31, 51, 36, 27, 47, 32, 52, 43, 35, 48, 40, 31, 51, 36, 28, 47, 32, 52,
+		44, 28, 48, 40, 25, 44, 36, 56, 41, 32, 52, 37, 29, 48, 40, 25, 45, 37, 50, 42,
+		34, 53, 38, 30, 50, 34, 26, 46, 31, 50, 42, 27, 47, 38, 30, 43, 35, 54, 46, 31,
+		51, 42, 27, 47, 39, 23, 43, 35, 55, 39, 31, 51, 36, 27, 47, 32, 52, 43, 35, 48,
+		40, 31, 44, 36, 28, 47, 32, 52, 44, 28, 48, 40, 25, 44, 36, 56, 41, 32, 52, 37,
+		29, 48, 33, 25, 45, 36, 49, 41, 33, 52, 37, 29, 49, 33, 53, 45, 30, 49, 41, 26,
+		46, 37, 22, 42, 34, 53, 38, 30, 50, 41, 26, 46, 38, 50, 42, 34, 47, 39, 31, 51,
+		36, 27, 47, 32, 52, 43, 28, 48, 40, 31, 44, 36, 28, 47, 32, 52, 37, 28, 48, 40,
+		25, 44, 36, 56, 41, 32, 52, 37, 29, 48, 33, 25, 45, 36, 49, 41, 26, 45, 37, 29,
+		42, 33, 53, 45, 30, 49, 41, 26, 46, 37, 22, 42, 34, 53, 38, 30, 50, 34, 26, 46,
+		31, 50, 42, 34, 47, 38, 30, 50, 35, 26, 46, 31, 51, 42, 27, 47, 39, 23, 43, 35,
+		55, 39, 31, 51, 36, 27, 47, 39, 24, 43, 35, 48, 40, 31, 51, 36, 28, 47
+	};
+
+	// Julian, moved to the Gregorian calendar
+	inline constexpr auto _Orthodox_Easter_days_of_March = std::array<std::uint8_t, 818uz>{
+		41, 60, 52, 44, 57, 48, 40, 60, 45, 36, 56, 41, 61, 52, 37, 57, 49, 33, 53, 45,
+		65, 49, 41, 61, 46, 37, 57, 49, 34, 53, 45, 65, 50, 41, 61, 46, 38, 57, 42, 62,
+		54, 38, 58, 50, 35, 54, 46, 38, 51, 42, 62, 47, 39, 58, 50, 35, 55, 46, 66, 51,
+		43, 62, 47, 39, 59, 43, 35, 55, 40, 59, 51, 36, 56, 47, 39, 52, 44, 63, 55, 40,
+		60, 51, 36, 56, 48, 32, 52, 44, 64, 48, 40, 60, 45, 36, 56, 41, 61, 52, 44, 57,
+		49, 40, 60, 45, 37, 56, 41, 61, 53, 37, 57, 49, 34, 53, 45, 65, 50, 42, 62, 47,
+		39, 58, 50, 35, 55, 46, 66, 51, 43, 62, 47, 39, 59, 43, 63, 55, 40, 59, 51, 36,
+		56, 47, 39, 52, 44, 63, 48, 40, 60, 51, 36, 56, 48, 67, 52, 44, 64, 48, 40, 60,
+		45, 36, 56, 41, 61, 52, 37, 57, 49, 40, 53, 45, 65, 56, 41, 61, 53, 37, 57, 49,
+		34, 53, 45, 65, 50, 41, 61, 46, 38, 57, 42, 62, 54, 45, 58, 50, 42, 61, 46, 38,
+		58, 42, 62, 54, 39, 58, 50, 35, 55, 46, 66, 51, 43, 62, 47, 39, 59, 51, 36, 56,
+		48, 67, 52, 44, 57, 48, 40, 60, 45, 64, 56, 41, 61, 52, 37, 57, 49, 40, 53, 45,
+		65, 49, 41, 61, 46, 37, 57, 49, 62, 53, 45, 65, 50, 41, 61, 46, 38, 57, 42, 62,
+		54, 38, 58, 50, 35, 54, 46, 66, 51, 42, 62, 54, 39, 58, 50, 35, 55, 46, 66, 51,
+		43, 62, 47, 39, 59, 43, 63, 55, 40, 59, 51, 43, 56, 47, 39, 59, 44, 63, 55, 40,
+		60, 51, 36, 56, 48, 67, 52, 44, 64, 48, 40, 60, 45, 36, 56, 48, 61, 53, 45, 58,
+		50, 41, 61, 46, 66, 57, 42, 62, 54, 38, 58, 50, 35, 54, 46, 66, 51, 42, 62, 47,
+		39, 58, 50, 63, 55, 46, 66, 51, 43, 62, 47, 39, 59, 43, 63, 55, 40, 59, 51, 36,
+		56, 47, 67, 52, 44, 63, 55, 40, 60, 51, 36, 56, 48, 67, 52, 44, 64, 48, 40, 60,
+		45, 64, 56, 41, 61, 52, 44, 57, 49, 40, 60, 45, 65, 56, 41, 61, 53, 37, 57, 49,
+		69, 53, 45, 65, 50, 41, 61, 46, 38, 57, 49, 62, 54, 45, 58, 50, 42, 61, 46, 66,
+		58, 42, 62, 54, 39, 58, 50, 35, 55, 46, 66, 51, 43, 62, 47, 39, 59, 50, 63, 55,
+		47, 66, 51, 43, 63, 47, 39, 59, 44, 63, 55, 40, 60, 51, 36, 56, 48, 67, 52, 44,
+		64, 55, 40, 60, 52, 36, 56, 48, 68, 52, 44, 64, 49, 40, 60, 45, 65, 56, 41, 61,
+		53, 44, 57, 49, 41, 60, 45, 65, 50, 41, 61, 53, 38, 57, 49, 69, 54, 45, 65, 50,
+		42, 61, 46, 38, 58, 49, 62, 54, 39, 58, 50, 42, 55, 46, 66, 58, 43, 63, 55, 40,
+		60, 51, 36, 56, 48, 67, 52, 44, 64, 48, 40, 60, 45, 64, 56, 48, 61, 52, 44, 64,
+		49, 40, 60, 45, 65, 56, 41, 61, 53, 37, 57, 49, 69, 53, 45, 65, 50, 41, 61, 53,
+		38, 57, 49, 69, 54, 45, 65, 50, 42, 61, 46, 66, 58, 42, 62, 54, 39, 58, 50, 42,
+		55, 46, 66, 51, 43, 62, 54, 39, 59, 50, 70, 55, 47, 66, 51, 43, 63, 47, 39, 59,
+		44, 63, 55, 40, 60, 51, 43, 56, 48, 67, 59, 44, 64, 55, 40, 60, 52, 37, 57, 49,
+		69, 53, 45, 65, 50, 41, 61, 46, 66, 57, 49, 62, 54, 45, 65, 50, 42, 61, 46, 66,
+		58, 42, 62, 54, 39, 58, 50, 70, 55, 46, 66, 51, 43, 62, 54, 39, 59, 50, 70, 55,
+		47, 66, 51, 43, 63, 47, 67, 59, 44, 63, 55, 40, 60, 51, 43, 56, 48, 67, 52, 44,
+		64, 55, 40, 60, 52, 71, 56, 48, 68, 52, 44, 64, 49, 40, 60, 45, 65, 56, 41, 61,
+		53, 44, 57, 49, 69, 60, 45, 65, 57, 41, 61, 53, 38, 57, 49, 69, 54, 46, 66, 51,
+		43, 62, 47, 67, 59, 50, 63, 55, 47, 66, 51, 43, 63, 47, 67, 59, 44, 63, 55, 40,
+		60, 51, 71, 56, 48, 67, 52, 44, 64, 55, 40, 60, 52, 71, 56, 48, 61, 52, 44, 64,
+		49, 68, 60, 45, 65, 56, 41, 61, 53, 44, 57, 49, 69, 53, 45, 65, 50, 41, 61, 53,
+		66, 57, 49, 69, 54, 45, 65, 50, 42, 61, 46, 66, 58, 42, 62, 54, 39, 58, 50, 70,
+		55, 46, 66, 58, 43, 62, 54, 39, 59, 50, 70, 55, 47, 66, 51, 43, 63, 47
+	};
+
+	// days of March, June, September and December
+	inline constexpr auto _March_Equinox_days = std::array<std::uint8_t, 818uz>{
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20,
+		20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20,
+		20, 19, 19, 20, 20, 19, 19, 20, 20, 19, 19, 20, 20, 19, 19, 20, 20, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 19, 20, 20,
+		20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20,
+		20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 19, 20, 20, 19, 19, 20,
+		20, 19, 19, 20, 20, 19, 19, 20, 20, 19, 19, 20, 20, 19, 19, 20, 20, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20,
+		20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 19, 20, 20, 20, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+		20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20
+	};
+
+	inline constexpr auto _June_Solstice_days = std::array<std::uint8_t, 818uz>{
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20,
+		21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 20, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 20, 21, 20, 20, 20, 21, 20, 20, 20, 21, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21,
+		21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 20, 20, 21, 21, 21, 21, 22,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21, 21, 20
+	};
+
+	inline constexpr auto _September_Equinox_days = std::array<std::uint8_t, 818uz>{
+		23, 23, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23,
+		23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 23, 23, 23,
+		24, 23, 23, 23, 24, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+		23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 23, 23, 23,
+		24, 23, 23, 23, 24, 23, 23, 23, 24, 23, 23, 23, 24, 23, 23, 23, 24, 23, 23, 23,
+		24, 23, 23, 23, 24, 23, 23, 23, 24, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+		23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+		23, 23, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23,
+		23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 22, 23, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 23, 23, 23,
+		24, 23, 23, 23, 24, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+		23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 23, 23,
+		23, 22, 23, 23, 23, 22, 23, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23,
+		23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22, 22, 23, 23, 22
+	};
+
+	inline constexpr auto _December_Solstice_days = std::array<std::uint8_t, 818uz>{
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 20, 21, 21, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 22, 22, 22,
+		23, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 20, 21, 21,
+		21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 20, 21, 21, 21, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21,
+		21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22,
+		22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 21, 21, 21, 22, 22, 22, 22,
+		23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 23, 22, 22, 22, 22, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+		22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22, 22, 21, 22, 22,
+		22, 21, 22, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21, 21, 22, 22, 21
+	};
+
+}
@@ -28,7 +28,12 @@
 
 #include <chrono>
 #include <vector>
+#include <span>
+#include <unordered_map>
+#include <algorithm>
 #include <utility>
+#include <stdexcept>
+#include <cstddef>
 
 
 namespace gregorian
@@ -55,10 +60,56 @@ namespace gregorian
 
 		[[nodiscard]] constexpr auto make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day;
 
+		// the same as make_holiday for every year of the period (the first year goes to the front of the output, which should have a place for every year)
+		constexpr void make_holidays(const util::years_period& p, std::span<std::chrono::year_month_day> output) const;
+
+		// rule which this one is made from (like Easter for Good Friday), if any
+		[[nodiscard]] constexpr auto get_anchor() const noexcept -> const annual_holiday*;
+
+		// the same as make_holidays, but from the holidays of the anchor for the same years (so that they can be shared by all rules made from it)
+		constexpr void make_holidays(std::span<const std::chrono::year_month_day> anchor_holidays, std::span<std::chrono::year_month_day> output) const;
+
 	private:
 
 		virtual constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day = 0;
 
+		// one virtual call per period rather than per year (rules can do better than the default loop over _make_holiday)
+		virtual constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept;
+
+		virtual constexpr auto _get_anchor() const noexcept -> const annual_holiday*;
+
+		// only called for rules with an anchor
+		virtual constexpr void _make_anchored_holidays(std::span<const std::chrono::year_month_day> anchor_holidays, std::span<std::chrono::year_month_day> output) const noexcept;
+
+	};
+
+
+
+	// makes holidays of rules for a period, so that each rule (and each anchor, even if it is not one of the rules) is made only once
+	class _holiday_maker
+	{
+
+	public:
+
+		explicit _holiday_maker(util::years_period p);
+
+	public:
+
+		void make_holidays(const annual_holiday& rule, std::span<std::chrono::year_month_day> output);
+
+	private:
+
+		auto _get_holidays(const annual_holiday& rule) -> std::span<const std::chrono::year_month_day>;
+
+	private:
+
+		util::years_period _period;
+		std::size_t _years;
+
+		std::unordered_map<const annual_holiday*, std::span<const std::chrono::year_month_day>> _made;
+		std::vector<std::vector<std::chrono::year_month_day>> _anchor_holidays; // for anchors which are not made into an output
+		// (moving a vector keeps its elements in place, so the spans stay valid)
+
 	};
 
 
@@ -72,23 +123,25 @@ namespace gregorian
 		const annual_holiday_storage& rules
 	) noexcept -> schedule
 	{
-		auto hols = schedule::dates{};
-
-        for (auto y = p.get_from(); y <= p.get_until(); ++y)
-			for (const auto& rule : rules)
-			{
-				const auto d = rule->make_holiday(y);
-				if (d.ok()) // skip rules that don't produce a holiday for this year
-					hols.insert(hols.end(), d);
-			}
-
-		return schedule{
+		const auto years = static_cast<std::size_t>((p.get_until() - p.get_from()).count()) + 1uz;
+
+		// all holidays of a rule at once, then all of them are sorted at once (rather than inserted one by one)
+		auto hols = std::vector<std::chrono::year_month_day>(years * rules.size());
+		auto output = std::span{ hols };
+		auto maker = _holiday_maker{ p };
+		for (const auto& rule : rules)
+		{
+			maker.make_holidays(*rule, output.first(years));
+			output = output.subspan(years);
+		}
+
+		return make_schedule(
 			util::days_period{
 				p.get_from() / FirstDayOfJanuary,
 				p.get_until() / LastDayOfDecember
 			},
-			std::move(hols)
-		};
+			std::move(hols) // make_schedule skips rules that don't produce a holiday for a year
+		);
 	}
 
 	inline auto make_holiday_schedule(
@@ -106,4 +159,79 @@ namespace gregorian
 		return _make_holiday(y);
 	}
 
+	inline constexpr void annual_holiday::make_holidays(const util::years_period& p, std::span<std::chrono::year_month_day> output) const
+	{
+		if (static_cast<std::size_t>((p.get_until() - p.get_from()).count()) + 1uz != output.size())
+			throw std::invalid_argument{ "Output should have a place for every year of the period" };
+
+		_make_holidays(p.get_from(), output);
+	}
+
+	inline constexpr void annual_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = _make_holiday(y++);
+	}
+
+	inline constexpr auto annual_holiday::get_anchor() const noexcept -> const annual_holiday*
+	{
+		return _get_anchor();
+	}
+
+	inline constexpr void annual_holiday::make_holidays(std::span<const std::chrono::year_month_day> anchor_holidays, std::span<std::chrono::year_month_day> output) const
+	{
+		if (!get_anchor())
+			throw std::invalid_argument{ "Rule should have an anchor" };
+
+		if (anchor_holidays.size() != output.size())
+			throw std::invalid_argument{ "Output should have a place for every holiday of the anchor" };
+
+		_make_anchored_holidays(anchor_holidays, output);
+	}
+
+	inline constexpr auto annual_holiday::_get_anchor() const noexcept -> const annual_holiday*
+	{
+		return nullptr;
+	}
+
+	inline constexpr void annual_holiday::_make_anchored_holidays(std::span<const std::chrono::year_month_day>, std::span<std::chrono::year_month_day>) const noexcept
+	{
+	}
+
+
+
+	inline _holiday_maker::_holiday_maker(util::years_period p) :
+		_period{ std::move(p) },
+		_years{ static_cast<std::size_t>((_period.get_until() - _period.get_from()).count()) + 1uz }
+	{
+	}
+
+	inline void _holiday_maker::make_holidays(const annual_holiday& rule, std::span<std::chrono::year_month_day> output)
+	{
+		if (const auto it = _made.find(&rule); it != _made.cend())
+		{
+			std::ranges::copy(it->second, output.begin());
+			return;
+		}
+
+		if (const auto* const anchor = rule.get_anchor())
+			rule.make_holidays(_get_holidays(*anchor), output);
+		else
+			rule.make_holidays(_period, output);
+
+		_made.emplace(&rule, output);
+	}
+
+	inline auto _holiday_maker::_get_holidays(const annual_holiday& rule) -> std::span<const std::chrono::year_month_day>
+	{
+		if (const auto it = _made.find(&rule); it != _made.cend())
+			return it->second;
+
+		const auto hols = std::span{ _anchor_holidays.emplace_back(_years) }; // the vector itself might move while its anchor is made
+		make_holidays(rule, hols);
+
+		return hols;
+	}
+
 }
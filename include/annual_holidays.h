@@ -23,9 +23,12 @@
 #pragma once
 
 #include "annual_holiday_interface.h"
+#include "anchor_tables.h"
 #include "schedule.h"
 
 #include <chrono>
+#include <span>
+#include <algorithm>
 #include <utility>
 
 
@@ -42,6 +45,7 @@ namespace gregorian
 	private:
 
 		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 	private:
 
@@ -57,6 +61,19 @@ namespace gregorian
 	private:
 
 		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
+
+	};
+
+
+
+	class _orthodox_easter_holiday final : public annual_holiday
+	{
+
+	private:
+
+		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 	};
 
@@ -73,6 +90,10 @@ namespace gregorian
 	private:
 
 		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
+
+		constexpr auto _get_anchor() const noexcept -> const annual_holiday* final;
+		constexpr void _make_anchored_holidays(std::span<const std::chrono::year_month_day> anchor_holidays, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 	private:
 
@@ -93,6 +114,7 @@ namespace gregorian
 	private:
 
 		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 	private:
 
@@ -111,6 +133,7 @@ namespace gregorian
 	private:
 
 		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 	private:
 
@@ -131,11 +154,18 @@ namespace gregorian
 		return { y, _md.month(), _md.day() };
 	}
 
+	inline constexpr void named_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = { y++, _md.month(), _md.day() };
+	}
+
 
 
 	// from https://en.wikipedia.org/wiki/Date_of_Easter
 
-	inline constexpr auto _easter_holiday::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	[[nodiscard]] constexpr auto _calculate_Easter(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
 	{
 		const auto Y = static_cast<int>(y);
 
@@ -168,6 +198,82 @@ namespace gregorian
 		return { y, std::chrono::month{ static_cast<unsigned>(n) }, std::chrono::day{ static_cast<unsigned>(p) } };
 	}
 
+	// from "Astronomical Algorithms" second edition 1998 by J.Meeus (Easter in the Julian calendar),
+	// then moved to the Gregorian calendar (the difference grows by a day in every century year which is not a leap year in it)
+
+	[[nodiscard]] constexpr auto _calculate_Orthodox_Easter(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
+	{
+		const auto Y = static_cast<int>(y);
+
+		const auto a = Y % 4;
+
+		const auto b = Y % 7;
+
+		const auto c = Y % 19;
+
+		const auto d = (19 * c + 15) % 30;
+
+		const auto e = (2 * a + 4 * b - d + 34) % 7;
+
+		const auto f = d + e + 114;
+
+		const auto julian_day_of_March = (f / 31 == 3 ? 0 : 31) + f % 31 + 1;
+
+		const auto difference = Y / 100 - Y / 400 - 2;
+
+		return std::chrono::sys_days{ y / std::chrono::March / std::chrono::day{ 1u } } + std::chrono::days{ julian_day_of_March - 1 + difference };
+	}
+
+
+	// anchor tables are generated from these formulas, so they should be the same
+	[[nodiscard]] constexpr auto _check_Easter_tables() noexcept -> bool
+	{
+		for (auto y = _anchor_tables_from; y <= _anchor_tables_until; ++y)
+		{
+			const auto i = _anchor_table_index(y);
+
+			if (_from_day_of_March(y, _Easter_days_of_March[i]) != _calculate_Easter(y))
+				return false;
+
+			if (_from_day_of_March(y, _Orthodox_Easter_days_of_March[i]) != _calculate_Orthodox_Easter(y))
+				return false;
+		}
+
+		return true;
+	}
+
+	static_assert(_check_Easter_tables(), "Easter tables should be the same as the formulas");
+
+
+	inline constexpr auto _easter_holiday::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return _from_day_of_March(y, _Easter_days_of_March[_anchor_table_index(y)]);
+		else
+			return _calculate_Easter(y);
+	}
+
+	inline constexpr void _easter_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = _easter_holiday::_make_holiday(y++);
+	}
+
+	inline constexpr auto _orthodox_easter_holiday::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return _from_day_of_March(y, _Orthodox_Easter_days_of_March[_anchor_table_index(y)]);
+		else
+			return _calculate_Orthodox_Easter(y);
+	}
+
+	inline constexpr void _orthodox_easter_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = _orthodox_easter_holiday::_make_holiday(y++);
+	}
 
 
 	inline constexpr offset_holiday::offset_holiday(const annual_holiday* const holiday, std::chrono::days offset) noexcept :
@@ -183,6 +289,28 @@ namespace gregorian
 		return std::chrono::sys_days{ d } + _offset;
 	}
 
+	inline constexpr void offset_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		const auto until = from + std::chrono::years{ static_cast<int>(output.size()) - 1 };
+		_holiday->make_holidays(util::years_period{ from, until }, output);
+
+		_make_anchored_holidays(output, output);
+	}
+
+	inline constexpr auto offset_holiday::_get_anchor() const noexcept -> const annual_holiday*
+	{
+		return _holiday;
+	}
+
+	inline constexpr void offset_holiday::_make_anchored_holidays(std::span<const std::chrono::year_month_day> anchor_holidays, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		std::ranges::transform(
+			anchor_holidays,
+			output.begin(),
+			[this](const std::chrono::year_month_day& d) { return std::chrono::year_month_day{ std::chrono::sys_days{ d } + _offset }; }
+		);
+	}
+
 
 
 	inline constexpr weekday_indexed_holiday::weekday_indexed_holiday(std::chrono::month_weekday mwd) noexcept :
@@ -196,6 +324,13 @@ namespace gregorian
 		return { _mwd.weekday_indexed() / _mwd.month() / y };
 	}
 
+	inline constexpr void weekday_indexed_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = { _mwd.weekday_indexed() / _mwd.month() / y++ };
+	}
+
 
 
 	inline constexpr weekday_last_holiday::weekday_last_holiday(std::chrono::month_weekday_last mwd) noexcept :
@@ -209,6 +344,13 @@ namespace gregorian
 		return { _mwd.weekday_last() / _mwd.month() / y };
 	}
 
+	inline constexpr void weekday_last_holiday::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+	{
+		auto y = from;
+		for (auto& d : output)
+			d = { _mwd.weekday_last() / _mwd.month() / y++ };
+	}
+
 
 
 	inline constexpr auto NewYearsDay = named_holiday{ FirstDayOfJanuary };
@@ -219,6 +361,7 @@ namespace gregorian
 	// because we do not want to cross a year's boundary, which we would have to do otherwise
 
 	inline constexpr auto _Easter = _easter_holiday{};
+	inline constexpr auto _OrthodoxEaster = _orthodox_easter_holiday{};
 
 	inline constexpr auto GoodFriday = offset_holiday{ &_Easter, std::chrono::days{ -2 } };
 	inline constexpr auto EasterMonday = offset_holiday{ &_Easter, std::chrono::days{ 1 } };
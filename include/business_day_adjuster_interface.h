@@ -23,6 +23,7 @@
 #pragma once
 
 #include <chrono>
+#include <concepts>
 
 
 namespace gregorian
@@ -63,6 +64,17 @@ namespace gregorian
 	};
 
 
+	// anything with adjust for both kinds of days, which algorithms take by its own type (rather than as business_day_adjuster&)
+	// so built-in adjusters (which are final and have their own, non virtual adjust) are dispatched statically
+	// and can be inlined into a loop, while business_day_adjuster& still goes through _adjust (e.g. for user-defined ones)
+	template<typename A>
+	concept business_day_adjuster_type = requires(const A& a, const std::chrono::year_month_day& ymd, const std::chrono::sys_days& sd, const calendar& cal)
+	{
+		{ a.adjust(ymd, cal) } -> std::same_as<std::chrono::year_month_day>;
+		{ a.adjust(sd, cal) } -> std::same_as<std::chrono::sys_days>;
+	};
+
+
 
 	inline auto business_day_adjuster::adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
 	{
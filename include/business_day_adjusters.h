@@ -26,6 +26,7 @@
 #include "calendar.h"
 
 #include <chrono>
+#include <stdexcept>
 
 
 namespace gregorian
@@ -34,6 +35,11 @@ namespace gregorian
 	class no_adjustment final : public business_day_adjuster
 	{
 
+	public:
+
+		[[nodiscard]] auto adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day;
+		[[nodiscard]] auto adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days;
+
 	private:
 
 		virtual auto _adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day final;
@@ -49,6 +55,11 @@ namespace gregorian
 	class following final : public business_day_adjuster
 	{
 
+	public:
+
+		[[nodiscard]] auto adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day;
+		[[nodiscard]] auto adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days;
+
 	private:
 
 		virtual auto _adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day final;
@@ -64,6 +75,11 @@ namespace gregorian
 	class preceding final : public business_day_adjuster
 	{
 
+	public:
+
+		[[nodiscard]] auto adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day;
+		[[nodiscard]] auto adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days;
+
 	private:
 
 		virtual auto _adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day final;
@@ -79,6 +95,11 @@ namespace gregorian
 	class nearest final : public business_day_adjuster
 	{
 
+	public:
+
+		[[nodiscard]] auto adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day;
+		[[nodiscard]] auto adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days;
+
 	private:
 
 		virtual auto _adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day final;
@@ -91,6 +112,21 @@ namespace gregorian
 
 
 
+	// built-in adjusters, for a convention which is only known at run time (e.g. it comes with a trade)
+	enum class business_day_convention
+	{
+		no_adjustment,
+		following,
+		preceding,
+		nearest
+	};
+
+	// a switch over the built-in adjusters rather than a virtual call (so it can be inlined into a loop)
+	[[nodiscard]] auto adjust(const std::chrono::year_month_day& ymd, const business_day_convention c, const calendar& cal) -> std::chrono::year_month_day;
+	[[nodiscard]] auto adjust(const std::chrono::sys_days& sd, const business_day_convention c, const calendar& cal) -> std::chrono::sys_days;
+
+
+
 	inline auto make_first_business_day(
 		const std::chrono::year_month& ym,
 		const calendar& cal
@@ -112,76 +148,126 @@ namespace gregorian
 
 
 
-	inline auto no_adjustment::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	inline auto adjust(const std::chrono::year_month_day& ymd, const business_day_convention c, const calendar& cal) -> std::chrono::year_month_day
+	{
+		switch (c)
+		{
+		case business_day_convention::no_adjustment:
+			return NoAdjustment.adjust(ymd, cal);
+		case business_day_convention::following:
+			return Following.adjust(ymd, cal);
+		case business_day_convention::preceding:
+			return Preceding.adjust(ymd, cal);
+		case business_day_convention::nearest:
+			return Nearest.adjust(ymd, cal);
+		}
+
+		throw std::invalid_argument{"Business day convention is not valid"};
+	}
+
+	inline auto adjust(const std::chrono::sys_days& sd, const business_day_convention c, const calendar& cal) -> std::chrono::sys_days
+	{
+		switch (c)
+		{
+		case business_day_convention::no_adjustment:
+			return NoAdjustment.adjust(sd, cal);
+		case business_day_convention::following:
+			return Following.adjust(sd, cal);
+		case business_day_convention::preceding:
+			return Preceding.adjust(sd, cal);
+		case business_day_convention::nearest:
+			return Nearest.adjust(sd, cal);
+		}
+
+		throw std::invalid_argument{"Business day convention is not valid"};
+	}
+
+
+
+	inline auto no_adjustment::adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
 	{
 		return ymd;
 	}
 
-	inline auto no_adjustment::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	inline auto no_adjustment::adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
 	{
 		return sd;
 	}
 
+	inline auto no_adjustment::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	{
+		return adjust(ymd, cal);
+	}
+
+	inline auto no_adjustment::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	{
+		return adjust(sd, cal);
+	}
 
 
-	inline auto following::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+
+	inline auto following::adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	{
+		return cal.next_business_day(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto following::adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
 	{
-		auto result = ymd;
-		while (!cal.is_business_day(result))
-			result = std::chrono::sys_days{ result } + std::chrono::days{ 1 };
+		return cal.next_business_day(sd);
+	}
 
-		return result;
+	inline auto following::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	{
+		return adjust(ymd, cal);
 	}
 
 	inline auto following::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
 	{
-		auto result = sd;
-		while (!cal.is_business_day(result))
-			result += std::chrono::days{ 1 };
-
-		return result;
+		return adjust(sd, cal);
 	}
 
 
 
-	inline auto preceding::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	inline auto preceding::adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
 	{
-		auto result = ymd;
-		while (!cal.is_business_day(result))
-			result = std::chrono::sys_days{ result } - std::chrono::days{ 1 };
+		return cal.previous_business_day(std::chrono::sys_days{ ymd });
+	}
 
-		return result;
+	inline auto preceding::adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	{
+		return cal.previous_business_day(sd);
 	}
 
-	inline auto preceding::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	inline auto preceding::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
 	{
-		auto result = sd;
-		while (!cal.is_business_day(result))
-			result -= std::chrono::days{ 1 };
+		return adjust(ymd, cal);
+	}
 
-		return result;
+	inline auto preceding::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	{
+		return adjust(sd, cal);
 	}
 
 
 
+	inline auto nearest::adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
+	{
+		return cal.nearest_business_day(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto nearest::adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
+	{
+		return cal.nearest_business_day(sd);
+	}
+
 	inline auto nearest::_adjust(const std::chrono::year_month_day& ymd, const calendar& cal) const -> std::chrono::year_month_day
 	{
-		const auto f = Following.adjust(ymd, cal);
-		const auto p = Preceding.adjust(ymd, cal);
-		if (std::chrono::sys_days{ f } - std::chrono::sys_days{ ymd } <= std::chrono::sys_days{ ymd } - std::chrono::sys_days{ p })
-			return f;
-		else
-			return p;
+		return adjust(ymd, cal);
 	}
 
 	inline auto nearest::_adjust(const std::chrono::sys_days& sd, const calendar& cal) const -> std::chrono::sys_days
 	{
-		const auto f = Following.adjust(sd, cal);
-		const auto p = Preceding.adjust(sd, cal);
-		if (f - sd <= sd - p)
-			return f;
-		else
-			return p;
+		return adjust(sd, cal);
 	}
 
 }
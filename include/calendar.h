@@ -25,15 +25,28 @@
 #include <period.h>
 #include <iota.h>
 #include <time_series.h>
+#include <unite_flat_sets.h>
 
 #include "weekend.h"
 #include "schedule.h"
 #include "business_day_adjuster_interface.h"
 
 #include <utility>
+#include <memory>
+#include <vector>
+#include <iterator>
 #include <chrono>
 #include <compare>
 #include <ranges>
+#include <stdexcept>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <execution>
+#include <type_traits>
+#include <expected>
+#include <system_error>
+#include <cstdint>
 
 
 namespace gregorian // should the namespace be called civil?
@@ -44,7 +57,32 @@ namespace gregorian // should the namespace be called civil?
 
 	public:
 
-		explicit calendar(weekend we, schedule hols);
+		// lazy calendar populates its cache of non business days a block (of about a year) at a time,
+		// the first time the block is used (most services only look at a few years around today)
+		// and indexes it once all of it has been populated,
+		// eager calendar (the default) populates and indexes all of it upfront
+		enum class caching
+		{
+			lazy,
+			eager
+		};
+
+		explicit calendar(weekend we, schedule hols, const caching c = caching::eager);
+
+		// with prebuilt non business days (e.g. mapped from a calendar database), so nothing is generated
+		// (bit i of the words is the day i days after the start of the period of hols, they have to be consistent with we and hols)
+		calendar(weekend we, schedule hols, std::span<const std::uint64_t> non_business_days);
+
+		// the same, but refers to the words rather than copies them (owner keeps them alive, e.g. a mapped file)
+		calendar(weekend we, schedule hols, std::span<const std::uint64_t> non_business_days, std::shared_ptr<const void> owner);
+
+		// the same, but refers to whole pages of words (see util::time_series), calendars which refer to the same page share it
+		calendar(weekend we, schedule hols, std::span<const std::uint64_t* const> non_business_day_pages, std::shared_ptr<const void> owner);
+
+	private:
+
+		// non_business_days have to be consistent with we and hols
+		calendar(weekend we, schedule hols, util::time_series<bool> non_business_days);
 
 	public:
 
@@ -56,6 +94,14 @@ namespace gregorian // should the namespace be called civil?
 		friend auto operator<=>(const calendar& cal1, const calendar& cal2) noexcept -> std::strong_ordering = delete;
 #endif
 
+#ifdef _MSC_BUILD 
+		[[nodiscard]] friend auto operator&(const calendar& cal1, const calendar& cal2) -> calendar;
+		[[nodiscard]] friend auto join(std::span<const calendar* const> cals) -> calendar;
+#else
+		friend auto operator&(const calendar& cal1, const calendar& cal2) -> calendar;
+		friend auto join(std::span<const calendar* const> cals) -> calendar;
+#endif
+
 	public:
 
 		[[nodiscard]] auto is_non_business_day(const std::chrono::year_month_day& ymd) const -> bool;
@@ -68,10 +114,58 @@ namespace gregorian // should the namespace be called civil?
 
 		[[nodiscard]] auto is_business_day(const std::chrono::sys_days& sd) const -> bool;
 
+		// the same as is_business_day, but the day has to be within the calendar (only asserted in debug builds)
+		// for loops over a range which has already been checked
+		[[nodiscard]] auto is_business_day_unchecked(const std::chrono::year_month_day& ymd) const noexcept -> bool;
+
+		[[nodiscard]] auto is_business_day_unchecked(const std::chrono::sys_days& sd) const noexcept -> bool;
+
+		// the same as is_business_day, but returns std::errc::argument_out_of_domain rather than throws
+		[[nodiscard]] auto try_is_business_day(const std::chrono::year_month_day& ymd) const noexcept -> std::expected<bool, std::errc>;
+
+		[[nodiscard]] auto try_is_business_day(const std::chrono::sys_days& sd) const noexcept -> std::expected<bool, std::errc>;
+
 		[[nodiscard]] auto count_business_days(const util::days_period& p) const -> std::size_t;
 
 		[[nodiscard]] auto count_business_days(const util::period<std::chrono::sys_days>& p) const -> std::size_t;
 
+		// number of business days in the calendar strictly before sd (rank)
+		[[nodiscard]] auto count_business_days_before(const std::chrono::sys_days& sd) const -> std::size_t;
+
+		// business day with a given number of business days before it (select, inverse of the above)
+		[[nodiscard]] auto nth_business_day(const std::size_t n) const -> std::chrono::sys_days;
+
+		// first business day on or after sd / last business day on or before sd
+		// (throw std::out_of_range if there is none within the calendar)
+		[[nodiscard]] auto next_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days;
+		[[nodiscard]] auto previous_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days;
+
+		// the nearer of the two above (next one if they are equally far), both are found in a single scan
+		[[nodiscard]] auto nearest_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days;
+
+	public:
+
+		// batch versions of the above (for a whole portfolio of dates at once)
+		// all the inputs are checked before anything is written to out (which has to be of the same size),
+		// so with std::execution::par the per-date work does not throw
+		// (without a policy std::execution::seq is used)
+		// a lazy calendar populates its blocks from the per-date work, which synchronises with other threads,
+		// so std::execution::unseq and std::execution::par_unseq must not be passed for lazy calendars
+
+		void is_business_day(std::span<const std::chrono::sys_days> sds, std::span<bool> out) const;
+
+		template<typename ExecutionPolicy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+		void is_business_day(ExecutionPolicy&& policy, std::span<const std::chrono::sys_days> sds, std::span<bool> out) const;
+
+		void count_business_days(std::span<const util::period<std::chrono::sys_days>> ps, std::span<std::size_t> out) const;
+
+		template<typename ExecutionPolicy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+		void count_business_days(ExecutionPolicy&& policy, std::span<const util::period<std::chrono::sys_days>> ps, std::span<std::size_t> out) const;
+
+	public:
+
 		// should below be standalone functions instead of member functions?
 
 		// is returning schedule the right thing to do?
@@ -87,7 +181,33 @@ namespace gregorian // should the namespace be called civil?
 
 	public:
 
-		void substitute(const business_day_adjuster& a);
+		// a is taken by its own type, so a built-in adjuster is dispatched statically (see business_day_adjuster_type)
+		template<business_day_adjuster_type A>
+		void substitute(const A& a);
+
+		// non business days which are the same as the ones of cal (a page of about 11 years at a time) become shared with cal
+		// (e.g. for versions of a calendar, which usually differ by a holiday or two), both calendars get populated
+		// returns the number of pages shared with cal
+		auto share_non_business_days(const calendar& cal) -> std::size_t;
+
+		// number of pages of non business days which are already shared with cal (nothing is compared or populated)
+		[[nodiscard]] auto count_shared_pages(const calendar& cal) const noexcept -> std::size_t;
+
+		// days of the period common to both calendars which are business days in one of them, but not in the other
+		// (e.g. what has changed between two versions of a calendar, pages they share are not looked at)
+		[[nodiscard]] auto find_differences(const calendar& cal) const -> std::vector<std::chrono::sys_days>;
+
+		// a new version of this calendar (e.g. once a holiday has been announced), with the holidays added and removed
+		// (the days have to be within the calendar and none of them can be both added and removed),
+		// only the non business days around the changes are written, the rest are shared with this calendar
+		// (all of them if it is populated, e.g. eager, a lazy one only shares the pages it has populated so far)
+		[[nodiscard]] auto derive(
+			std::span<const std::chrono::year_month_day> added,
+			std::span<const std::chrono::year_month_day> removed
+		) const -> calendar;
+
+		// the same, but holidays within the period of s become the ones of s (e.g. a newly published year or two)
+		[[nodiscard]] auto derive(const schedule& s) const -> calendar;
 
 	public:
 
@@ -98,6 +218,8 @@ namespace gregorian // should the namespace be called civil?
 
 		auto _is_non_business_day(const std::chrono::year_month_day& ymd) const noexcept -> bool;
 
+		auto _contains(const std::chrono::sys_days& sd) const noexcept -> bool;
+
 	private:
 
 		weekend _we;
@@ -107,7 +229,11 @@ namespace gregorian // should the namespace be called civil?
 
 		struct _cache
 		{
-			explicit _cache(const calendar& cal);
+			_cache(const calendar& cal, const caching c);
+
+			explicit _cache(util::time_series<bool> nbds);
+
+			static auto _make_lazy_non_business_days(const calendar& cal) -> util::time_series<bool>;
 
 			void substitute(
 				const std::chrono::year_month_day& out,
@@ -118,9 +244,10 @@ namespace gregorian // should the namespace be called civil?
 			util::time_series<bool> non_business_days;
 			// calendars follow a 28 year cycle (apart of Easter, which has its own, much longer cycle)
 			// so maybe this could be done better (only cache a single cycle)
+			// (compressed_calendar does it for calendars generated by rules, with the 400 year Gregorian cycle)
 		};
 
-		_cache _cch; // if we decide to cache on demand, then [[nodiscard]] might not be the right thing to do in this class
+		_cache _cch;
 
 	};
 
@@ -136,32 +263,129 @@ namespace gregorian // should the namespace be called civil?
 	}
 
 
-	[[nodiscard]] inline auto operator|(const calendar& cal1, const calendar& cal2) -> calendar
+	// union of all the non business days over the period common to all the calendars
+	// (if all of them are fully populated, the cache is a word by word or of theirs,
+	// otherwise the result is lazy, as populating the inputs is what we want to avoid)
+#ifdef _MSC_BUILD 
+	[[nodiscard]] inline auto join(std::span<const calendar* const> cals) -> calendar
+#else
+	inline auto join(std::span<const calendar* const> cals) -> calendar
+#endif
 	{
-		const auto p = cal1.get_schedule().get_period() & cal2.get_schedule().get_period();
-		const auto s = cal1.get_schedule() | cal2.get_schedule();
+		if (cals.empty())
+			throw std::invalid_argument{ "There should be at least one calendar to join" };
 
-		return calendar{
-			cal1.get_weekend() | cal2.get_weekend(),
-			schedule{ p, s.get_dates() }
-		};
+		auto p = cals.front()->get_schedule().get_period();
+		auto we = cals.front()->get_weekend();
+		auto populated = true;
+		for (const auto* cal : cals)
+		{
+			p = p & cal->get_schedule().get_period();
+			we = we | cal->get_weekend();
+			populated = populated && cal->_cch.non_business_days.is_populated();
+		}
+
+		// all the dates at once (the ones outside of p are dropped by schedule)
+		auto dss = std::vector<const schedule::dates*>{};
+		dss.reserve(cals.size());
+		for (const auto* cal : cals)
+			dss.push_back(&cal->get_schedule().get_dates());
+
+		auto hols = schedule{ p, util::unite_flat_sets(std::span<const schedule::dates* const>{ dss }) };
+
+		if (!populated)
+			return calendar{ std::move(we), std::move(hols) };
+
+		auto non_business_days = util::time_series<bool>{ p };
+		for (const auto* cal : cals)
+			non_business_days |= cal->_cch.non_business_days;
+
+		return calendar{ std::move(we), std::move(hols), std::move(non_business_days) };
+	}
+
+
+	[[nodiscard]] inline auto operator|(const calendar& cal1, const calendar& cal2) -> calendar
+	{
+		return join(std::array{ &cal1, &cal2 });
 	}
 
+	// with different weekends a day can be a non business day in both calendars but not in the result
+	// (a weekend in one of them and a holiday in the other),
+	// so the cache is a word by word and of theirs only if the weekends are the same
+#ifdef _MSC_BUILD 
 	[[nodiscard]] inline auto operator&(const calendar& cal1, const calendar& cal2) -> calendar
+#else
+	inline auto operator&(const calendar& cal1, const calendar& cal2) -> calendar
+#endif
 	{
-		return calendar{
-			cal1.get_weekend() & cal2.get_weekend(),
-			cal1.get_schedule() & cal2.get_schedule()
-		};
+		auto we = cal1.get_weekend() & cal2.get_weekend();
+		auto hols = cal1.get_schedule() & cal2.get_schedule();
+
+		if (
+			cal1.get_weekend() != cal2.get_weekend() ||
+			!cal1._cch.non_business_days.is_populated() ||
+			!cal2._cch.non_business_days.is_populated()
+		)
+			return calendar{ std::move(we), std::move(hols) };
+
+		auto non_business_days = util::time_series<bool>{ hols.get_period() };
+		non_business_days |= cal1._cch.non_business_days;
+		non_business_days &= cal2._cch.non_business_days;
+
+		return calendar{ std::move(we), std::move(hols), std::move(non_business_days) };
 	}
 
 
 	inline calendar::calendar(
 		weekend we,
-		schedule hols
+		schedule hols,
+		const caching c
+	) :	_we{ std::move(we) },
+		_hols{ std::move(hols) },
+		_cch{ *this, c }
+	{
+	}
+
+	inline calendar::calendar(
+		weekend we,
+		schedule hols,
+		util::time_series<bool> non_business_days
 	) :	_we{ std::move(we) },
 		_hols{ std::move(hols) },
-		_cch{ *this }
+		_cch{ std::move(non_business_days) }
+	{
+	}
+
+
+	inline calendar::calendar(
+		weekend we,
+		schedule hols,
+		std::span<const std::uint64_t> non_business_days
+	) :	_we{ std::move(we) },
+		_hols{ std::move(hols) },
+		_cch{ util::time_series<bool>{ _hols.get_period(), non_business_days } }
+	{
+	}
+
+	inline calendar::calendar(
+		weekend we,
+		schedule hols,
+		std::span<const std::uint64_t> non_business_days,
+		std::shared_ptr<const void> owner
+	) :	_we{ std::move(we) },
+		_hols{ std::move(hols) },
+		_cch{ util::time_series<bool>{ _hols.get_period(), non_business_days, std::move(owner) } }
+	{
+	}
+
+	inline calendar::calendar(
+		weekend we,
+		schedule hols,
+		std::span<const std::uint64_t* const> non_business_day_pages,
+		std::shared_ptr<const void> owner
+	) :	_we{ std::move(we) },
+		_hols{ std::move(hols) },
+		_cch{ util::time_series<bool>{ _hols.get_period(), non_business_day_pages, std::move(owner) } }
 	{
 	}
 
@@ -172,26 +396,163 @@ namespace gregorian // should the namespace be called civil?
 	}
 
 
-	inline void calendar::substitute(const business_day_adjuster& a)
+	template<business_day_adjuster_type A>
+	void calendar::substitute(const A& a)
 	{
-		auto sub_cal = *this;
+		// holidays are adjusted against this calendar as it is before the substitution,
+		// so substitute days are its business days and never clash with the holidays which are kept
+		// (then a single pass splits the holidays, a single merge makes the new dates
+		// and the new cache is the old one with the substitute days set)
+		using date = schedule::dates::value_type;
+
+		const auto& hols = _hols.get_dates();
+
+		auto kept = std::vector<date>{};
+		kept.reserve(hols.size());
+
+		auto substitutes = std::vector<date>{};
+
+		auto cch = _cch;
 
-		for (const auto& holiday : _hols.get_dates())
+		for (const auto& holiday : hols)
 		{
-			sub_cal._hols -= holiday;
-			if (sub_cal._is_non_business_day(holiday))
+			if (_we.is_weekend(holiday))
 			{
 				const auto substitute_day = a.adjust(holiday, *this);
-				sub_cal._hols += substitute_day;
-				sub_cal._cch.substitute(holiday, substitute_day, _we);
+				substitutes.push_back(substitute_day);
+				cch.substitute(holiday, substitute_day, _we);
 			}
 			else
+				kept.push_back(holiday);
+		}
+
+		// our adjusters keep the order, but there is no such requirement
+		// (two holidays can also share a substitute day, e.g. Christmas on Saturday and Boxing Day on Sunday)
+		if (!std::ranges::is_sorted(substitutes))
+			std::ranges::sort(substitutes);
+		const auto duplicates = std::ranges::unique(substitutes);
+		substitutes.erase(duplicates.begin(), duplicates.end());
+
+		auto ds = std::vector<date>{};
+		ds.reserve(kept.size() + substitutes.size());
+		std::ranges::set_union(kept, substitutes, std::back_inserter(ds));
+
+		// substitution writes through operator[], which drops the index
+		// (if some blocks are still to be populated, the last of them will rebuild it)
+		if (cch.non_business_days.is_populated())
+			cch.non_business_days.build_rank_index();
+
+		_hols = schedule{ _hols.get_period(), schedule::dates{ std::sorted_unique, std::move(ds) } };
+		_cch = std::move(cch);
+	}
+
+
+	inline auto calendar::share_non_business_days(const calendar& cal) -> std::size_t
+	{
+		return _cch.non_business_days.share_pages(cal._cch.non_business_days);
+	}
+
+	inline auto calendar::count_shared_pages(const calendar& cal) const noexcept -> std::size_t
+	{
+		return _cch.non_business_days.count_shared_pages(cal._cch.non_business_days);
+	}
+
+	inline auto calendar::find_differences(const calendar& cal) const -> std::vector<std::chrono::sys_days>
+	{
+		return _cch.non_business_days.find_differences(cal._cch.non_business_days);
+	}
+
+
+	inline auto calendar::derive(
+		std::span<const std::chrono::year_month_day> added,
+		std::span<const std::chrono::year_month_day> removed
+	) const -> calendar
+	{
+		using date = schedule::dates::value_type;
+
+		const auto& p = _hols.get_period();
+
+		const auto to_dates = [&p](std::span<const std::chrono::year_month_day> ymds)
+		{
+			auto ds = std::vector<date>{};
+			ds.reserve(ymds.size());
+			for (const auto& ymd : ymds)
 			{
-				sub_cal._hols += holiday;
+				if (!ymd.ok())
+					throw std::invalid_argument{ "Day is not valid" };
+				if (!p.contains(ymd))
+					throw std::out_of_range{ "Request is not consistent with from/until" };
+				ds.push_back(ymd);
 			}
-		}
 
-		*this = std::move(sub_cal);
+			std::ranges::sort(ds);
+			const auto duplicates = std::ranges::unique(ds);
+			ds.erase(duplicates.begin(), duplicates.end());
+
+			return ds;
+		};
+
+		const auto adds = to_dates(added);
+		const auto removes = to_dates(removed);
+
+		auto both = std::vector<date>{};
+		std::ranges::set_intersection(adds, removes, std::back_inserter(both));
+		if (!both.empty())
+			throw std::invalid_argument{ "Holiday cannot be both added and removed" };
+
+		const auto& hols = _hols.get_dates();
+
+		auto with_adds = std::vector<date>{};
+		with_adds.reserve(hols.size() + adds.size());
+		std::ranges::set_union(hols, adds, std::back_inserter(with_adds));
+
+		auto ds = std::vector<date>{};
+		ds.reserve(with_adds.size());
+		std::ranges::set_difference(with_adds, removes, std::back_inserter(ds));
+
+		// the copy shares its populated pages (and its generator, if it is lazy) with this calendar,
+		// writes unshare just the pages with the changes (a lazy calendar populates their blocks first,
+		// its generator still knows the old holidays, but they are the same as the new ones everywhere else)
+		auto cal = *this;
+
+		// (a holiday on a weekend does not change anything, so its page is not written to)
+		for (const auto& d : adds)
+			if (!_we.is_weekend(d))
+				cal._cch.non_business_days[d] = true;
+		for (const auto& d : removes)
+			if (!_we.is_weekend(d)) // we allow a holiday on a weekend
+				cal._cch.non_business_days[d] = false;
+
+		// writes through operator[] drop the index
+		// (if some blocks are still to be populated, the last of them will rebuild it)
+		if (cal._cch.non_business_days.is_populated())
+			cal._cch.non_business_days.build_rank_index();
+
+		cal._hols = schedule{ p, schedule::dates{ std::sorted_unique, std::move(ds) } };
+
+		return cal;
+	}
+
+	inline auto calendar::derive(const schedule& s) const -> calendar
+	{
+		using date = schedule::dates::value_type;
+
+		const auto& sp = s.get_period();
+		if (!_hols.get_period().contains(sp))
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+
+		const auto& hols = _hols.get_dates();
+		const auto first = std::ranges::lower_bound(hols, date{ sp.get_from() });
+		const auto last = std::ranges::upper_bound(hols, date{ sp.get_until() });
+		const auto current = std::ranges::subrange{ first, last };
+
+		auto added = std::vector<std::chrono::year_month_day>{};
+		std::ranges::set_difference(s.get_dates(), current, std::back_inserter(added));
+
+		auto removed = std::vector<std::chrono::year_month_day>{};
+		std::ranges::set_difference(current, s.get_dates(), std::back_inserter(removed));
+
+		return derive(added, removed);
 	}
 
 
@@ -215,11 +576,34 @@ namespace gregorian // should the namespace be called civil?
 		return !is_non_business_day(sd);
 	}
 
-	// alternative implementation would be to cache the number of business days per month (and possibly per year)
-	// like described in the following article:
-	// https://www.clarusft.com/implementing-bus252-daycount-convention/
-	// or to cache the substituted holidays in an ordered vector, so we know how many holidays are between
-	// from and until, which we'll need to further adjust by the number of weekends between the same 2 dates
+	inline auto calendar::is_business_day_unchecked(const std::chrono::year_month_day& ymd) const noexcept -> bool
+	{
+		return is_business_day_unchecked(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto calendar::is_business_day_unchecked(const std::chrono::sys_days& sd) const noexcept -> bool
+	{
+		return !_cch.non_business_days.get_unchecked(sd);
+	}
+
+	inline auto calendar::try_is_business_day(const std::chrono::year_month_day& ymd) const noexcept -> std::expected<bool, std::errc>
+	{
+		return try_is_business_day(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto calendar::try_is_business_day(const std::chrono::sys_days& sd) const noexcept -> std::expected<bool, std::errc>
+	{
+		const auto is_non_bd = _cch.non_business_days.try_get(sd);
+		if (!is_non_bd)
+			return std::unexpected{ is_non_bd.error() };
+
+		return !*is_non_bd;
+	}
+
+	// non_business_days keeps a rank index (cumulative count of non business days per chunk),
+	// so the count does not depend on the length of the period
+	// (similar in spirit to caching the number of business days per month, like described in the following article:
+	// https://www.clarusft.com/implementing-bus252-daycount-convention/)
 	inline auto calendar::count_business_days(const util::days_period& period) const -> std::size_t
 	{
 		const auto non_business_days = _cch.non_business_days.count(period);
@@ -239,11 +623,111 @@ namespace gregorian // should the namespace be called civil?
 		return calendar_days.count() - non_business_days + 1uz;
 	}
 
+	inline void calendar::is_business_day(std::span<const std::chrono::sys_days> sds, std::span<bool> out) const
+	{
+		is_business_day(std::execution::seq, sds, out);
+	}
+
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void calendar::is_business_day(ExecutionPolicy&& policy, std::span<const std::chrono::sys_days> sds, std::span<bool> out) const
+	{
+		if (sds.size() != out.size())
+			throw std::invalid_argument{ "Input and output sizes are not consistent" };
+
+		// only the earliest and the latest days matter (and min/max vectorise well)
+		if (!sds.empty())
+		{
+			const auto [min, max] = std::ranges::minmax(sds);
+			if (!_contains(min) || !_contains(max))
+				throw std::out_of_range{ "Request is not consistent with from/until" };
+		}
+
+		std::transform(
+			std::forward<ExecutionPolicy>(policy),
+			sds.begin(),
+			sds.end(),
+			out.begin(),
+			[this](const std::chrono::sys_days& sd) { return is_business_day_unchecked(sd); }
+		);
+	}
+
+	inline void calendar::count_business_days(std::span<const util::period<std::chrono::sys_days>> ps, std::span<std::size_t> out) const
+	{
+		count_business_days(std::execution::seq, ps, out);
+	}
+
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void calendar::count_business_days(ExecutionPolicy&& policy, std::span<const util::period<std::chrono::sys_days>> ps, std::span<std::size_t> out) const
+	{
+		if (ps.size() != out.size())
+			throw std::invalid_argument{ "Input and output sizes are not consistent" };
+
+		for (const auto& p : ps)
+			if (!_contains(p.get_from()) || !_contains(p.get_until()))
+				throw std::out_of_range{ "Request is not consistent with from/until" };
+
+		// checked above, so count_business_days does not throw here
+		std::transform(
+			std::forward<ExecutionPolicy>(policy),
+			ps.begin(),
+			ps.end(),
+			out.begin(),
+			[this](const util::period<std::chrono::sys_days>& p) { return count_business_days(p); }
+		);
+	}
+
+	inline auto calendar::count_business_days_before(const std::chrono::sys_days& sd) const -> std::size_t
+	{
+		return _cch.non_business_days.rank(sd, false);
+	}
+
+	inline auto calendar::nth_business_day(const std::size_t n) const -> std::chrono::sys_days
+	{
+		return _cch.non_business_days.select(n, false);
+	}
+
+	inline auto calendar::next_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days
+	{
+		const auto found = _cch.non_business_days.find_next(sd, false);
+		if (!found)
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+
+		return *found;
+	}
+
+	inline auto calendar::previous_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days
+	{
+		const auto found = _cch.non_business_days.find_previous(sd, false);
+		if (!found)
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+
+		return *found;
+	}
+
+	inline auto calendar::nearest_business_day(const std::chrono::sys_days& sd) const -> std::chrono::sys_days
+	{
+		const auto [previous, next] = _cch.non_business_days.find_around(sd, false);
+		if (!previous || !next) // we need both to tell which one is nearer
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+
+		if (*next - sd <= sd - *previous)
+			return *next;
+		else
+			return *previous;
+	}
+
 	inline auto calendar::make_business_days_schedule(util::days_period p) const -> schedule
 	{
+		// check the whole period once, rather than every day
+		const auto& cp = _hols.get_period();
+		if (p.get_from() < cp.get_from() || p.get_until() > cp.get_until())
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+
 		const auto is_bd = [this](const std::chrono::year_month_day& ymd)
 		{
-			return is_business_day(ymd);
+			return is_business_day_unchecked(ymd);
 		};
 
 #ifdef _MSC_BUILD
@@ -273,6 +757,13 @@ namespace gregorian // should the namespace be called civil?
 	}
 
 
+	inline auto calendar::_contains(const std::chrono::sys_days& sd) const noexcept -> bool
+	{
+		const auto& p = _hols.get_period();
+		return sd >= std::chrono::sys_days{ p.get_from() } && sd <= std::chrono::sys_days{ p.get_until() };
+	}
+
+
 	inline auto calendar::get_weekend() const noexcept -> const weekend&
 	{
 		return _we;
@@ -284,9 +775,12 @@ namespace gregorian // should the namespace be called civil?
 	}
 
 
-	inline calendar::_cache::_cache(const calendar& cal)
-		: non_business_days{ cal.get_schedule().get_period() }
+	inline calendar::_cache::_cache(const calendar& cal, const caching c)
+		: non_business_days{ c == caching::lazy ? _make_lazy_non_business_days(cal) : util::time_series<bool>{ cal.get_schedule().get_period() } }
 	{
+		if (c == caching::lazy)
+			return;
+
 		const auto [f, u] = cal.get_schedule().get_period().from_until();
 		for (
 			auto d = f;
@@ -294,6 +788,27 @@ namespace gregorian // should the namespace be called civil?
 			d = std::chrono::sys_days{ d } + std::chrono::days{ 1 }
 		)
 			non_business_days[d] = cal._is_non_business_day(d);
+
+		non_business_days.build_rank_index();
+	}
+
+	inline calendar::_cache::_cache(util::time_series<bool> nbds)
+		: non_business_days{ std::move(nbds) }
+	{
+		non_business_days.build_rank_index();
+	}
+
+	inline auto calendar::_cache::_make_lazy_non_business_days(const calendar& cal) -> util::time_series<bool>
+	{
+		// the generator can not refer to cal (calendars are copied and moved), so it has its own copy of holidays
+		// (substitute only writes to populated blocks, so the rest still come from the original holidays)
+		return util::time_series<bool>{
+			cal.get_schedule().get_period(),
+			[we = cal._we, hols = std::make_shared<const schedule>(cal._hols)](const std::chrono::sys_days& sd)
+			{
+				return we.is_weekend(sd) || hols->contains(sd);
+			}
+		};
 	}
 
 
@@ -26,6 +26,12 @@
 #include "business_day_adjusters.h"
 
 #include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <span>
+#include <algorithm>
+#include <execution>
+#include <type_traits>
 
 
 namespace gregorian
@@ -37,17 +43,29 @@ namespace gregorian
 		const calendar& cal
 	) -> std::chrono::sys_days
 	{
-		auto result = sd;
+		// shift in terms of business day ranks (rather than step one business day at a time),
+		// so it takes the same time for any n
 
 		const auto _n = n.count();
 		if (_n > std::chrono::days::rep{ 0 })
-			for (auto i = std::chrono::days::rep{ 0 }; i < _n; ++i)
-				result = Following.adjust(result + std::chrono::days{ 1 }, cal);
+		{
+			// sd + 1 has this many business days before it, so the result is the one with _n - 1 more
+			const auto r = cal.count_business_days_before(sd + std::chrono::days{ 1 });
+			return cal.nth_business_day(r + static_cast<std::size_t>(_n) - 1uz);
+		}
 		else if (_n < std::chrono::days::rep{ 0 })
-			for (auto i = std::chrono::days::rep{ 0 }; i > _n; --i)
-				result = Preceding.adjust(result - std::chrono::days{ 1 }, cal);
+		{
+			// number of business days up to (and including) sd - 1
+			const auto previous = sd - std::chrono::days{ 1 };
+			const auto r = cal.count_business_days_before(previous) + (cal.is_business_day(previous) ? 1uz : 0uz);
+			const auto back = static_cast<std::size_t>(-_n);
+			if (r < back)
+				throw std::out_of_range{ "Request is not consistent with from/until" };
 
-		return result;
+			return cal.nth_business_day(r - back);
+		}
+		else
+			return sd;
 	}
 
 	[[nodiscard]] inline auto shift_business_days(
@@ -60,4 +78,50 @@ namespace gregorian
 		return shift_business_days(std::chrono::sys_days{ ymd }, n, cal);
 	}
 
+	// batch version (the same shift for all the days, out has to be of the same size as sds)
+	// inputs are checked before any output is written (so that with std::execution::par nothing throws from within the algorithm)
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void shift_business_days(
+		ExecutionPolicy&& policy,
+		std::span<const std::chrono::sys_days> sds,
+		const std::chrono::days& n,
+		const calendar& cal,
+		std::span<std::chrono::sys_days> out
+	)
+	{
+		if (sds.size() != out.size())
+			throw std::invalid_argument{ "Input and output sizes are not consistent" };
+
+		if (sds.empty())
+			return;
+
+		// a shift by the same n is monotonic in the day, so if the earliest and the latest days can be shifted,
+		// all the days in between can be shifted as well (this throws out_of_range otherwise)
+		const auto [min, max] = std::ranges::minmax(sds);
+		static_cast<void>(shift_business_days(min, n, cal));
+		static_cast<void>(shift_business_days(max, n, cal));
+
+		std::transform(
+			std::forward<ExecutionPolicy>(policy),
+			sds.begin(),
+			sds.end(),
+			out.begin(),
+			[&](const std::chrono::sys_days& sd)
+			{
+				return shift_business_days(sd, n, cal);
+			}
+		);
+	}
+
+	inline void shift_business_days(
+		std::span<const std::chrono::sys_days> sds,
+		const std::chrono::days& n,
+		const calendar& cal,
+		std::span<std::chrono::sys_days> out
+	)
+	{
+		shift_business_days(std::execution::seq, sds, n, cal, out);
+	}
+
 }
@@ -0,0 +1,358 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <period.h>
+#include <time_series.h>
+
+#include "weekend.h"
+#include "schedule.h"
+#include "calendar.h"
+#include "annual_holiday_interface.h"
+#include "business_day_adjuster_interface.h"
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	// Gregorian calendar repeats itself every 400 years (which is also a whole number of weeks),
+	// so weekends and holidays like fixed dates or n-th weekday of a month (and their substitutions) do too
+	constexpr auto GregorianCycle = std::chrono::days{ 146097 };
+
+	static_assert(std::chrono::duration_cast<std::chrono::days>(std::chrono::years{ 400 }) == GregorianCycle);
+
+
+
+	// calendar generated by annual_holiday rules over a long period (think 1600 - 2400),
+	// which keeps a single cycle of non business days from the periodic rules (and weekends)
+	// and a sparse list of the days which differ from it (Easter based holidays, one-offs, etc.)
+	// so its size does not depend on the length of the period (apart of the exceptions)
+	//
+	// should it be the way calendar::_cache works for such calendars?
+	class compressed_calendar final
+	{
+
+	public:
+
+		// holidays from the rules, plus one-off holidays (jubilees, funerals, etc.)
+		explicit compressed_calendar(
+			weekend we,
+			const util::years_period& p,
+			const annual_holiday_storage& rules,
+			const schedule::dates& one_off_holidays = schedule::dates{}
+		);
+
+		// the same, but holidays from the rules which fall on a weekend are substituted like calendar::substitute does
+		// (one-off holidays are not substituted)
+		explicit compressed_calendar(
+			weekend we,
+			const util::years_period& p,
+			const annual_holiday_storage& rules,
+			const business_day_adjuster& substitution,
+			const schedule::dates& one_off_holidays = schedule::dates{}
+		);
+
+	private:
+
+		explicit compressed_calendar(
+			weekend we,
+			const util::years_period& p,
+			const annual_holiday_storage& rules,
+			const business_day_adjuster* const substitution,
+			const schedule::dates& one_off_holidays
+		);
+
+	public:
+
+		// the same semantics as calendar's ones
+
+		[[nodiscard]] auto is_non_business_day(const std::chrono::year_month_day& ymd) const -> bool;
+
+		[[nodiscard]] auto is_non_business_day(const std::chrono::sys_days& sd) const -> bool;
+
+		[[nodiscard]] auto is_business_day(const std::chrono::year_month_day& ymd) const -> bool;
+
+		[[nodiscard]] auto is_business_day(const std::chrono::sys_days& sd) const -> bool;
+
+		[[nodiscard]] auto count_business_days(const util::days_period& p) const -> std::size_t;
+
+		[[nodiscard]] auto count_business_days(const util::period<std::chrono::sys_days>& p) const -> std::size_t;
+
+	public:
+
+		// full calendar for a part of the period (to be used with adjusters, etc.)
+		// (holidays on weekends are not kept, but it has the same business days)
+		[[nodiscard]] auto make_calendar(const util::days_period& p) const -> calendar;
+
+	public:
+
+		[[nodiscard]] auto get_weekend() const noexcept -> const weekend&;
+		[[nodiscard]] auto get_period() const noexcept -> util::days_period;
+
+		// number of days which differ from the cycle (to help with testing)
+		[[nodiscard]] auto get_exceptions_size() const noexcept -> std::size_t;
+
+	private:
+
+		// number of non business days in the cycle(s) in [from, from + offset)
+		auto _cycle_rank(const std::size_t offset) const -> std::size_t;
+
+		void _check(const std::chrono::sys_days& sd) const;
+
+	private:
+
+		weekend _we;
+
+		util::period<std::chrono::sys_days> _period;
+
+		// starts with the period (and is shorter than GregorianCycle only if the period is)
+		util::time_series<bool> _cycle;
+		std::size_t _cycle_length;
+		std::size_t _cycle_non_business_days;
+
+		// both are sorted
+		std::vector<std::chrono::sys_days> _added; // non business days which are not in the cycle
+		std::vector<std::chrono::sys_days> _removed; // business days which are non business days in the cycle
+
+	};
+
+
+
+	// rule repeats itself with the Gregorian cycle (we only need to check a single cycle)
+	inline auto _is_periodic(const annual_holiday& rule, const std::chrono::year& from) noexcept -> bool
+	{
+		for (auto y = from; y < from + std::chrono::years{ 400 }; ++y)
+		{
+			const auto d1 = rule.make_holiday(y);
+			const auto d2 = rule.make_holiday(y + std::chrono::years{ 400 });
+
+			if (d1.ok() != d2.ok())
+				return false;
+
+			if (d1.ok() && std::chrono::sys_days{ d2 } - std::chrono::sys_days{ d1 } != GregorianCycle)
+				return false;
+		}
+
+		return true;
+	}
+
+
+	inline compressed_calendar::compressed_calendar(
+		weekend we,
+		const util::years_period& p,
+		const annual_holiday_storage& rules,
+		const schedule::dates& one_off_holidays
+	) :
+		compressed_calendar{ std::move(we), p, rules, nullptr, one_off_holidays }
+	{
+	}
+
+	inline compressed_calendar::compressed_calendar(
+		weekend we,
+		const util::years_period& p,
+		const annual_holiday_storage& rules,
+		const business_day_adjuster& substitution,
+		const schedule::dates& one_off_holidays
+	) :
+		compressed_calendar{ std::move(we), p, rules, &substitution, one_off_holidays }
+	{
+	}
+
+	inline compressed_calendar::compressed_calendar(
+		weekend we,
+		const util::years_period& p,
+		const annual_holiday_storage& rules,
+		const business_day_adjuster* const substitution,
+		const schedule::dates& one_off_holidays
+	) :
+		_we{ std::move(we) },
+		_period{
+			std::chrono::sys_days{ p.get_from() / FirstDayOfJanuary },
+			std::chrono::sys_days{ p.get_until() / LastDayOfDecember }
+		},
+		_cycle{
+			util::days_period{
+				_period.get_from(),
+				std::min(_period.get_until(), _period.get_from() + GregorianCycle - std::chrono::days{ 1 })
+			}
+		},
+		_cycle_length{ static_cast<std::size_t>(std::min(_period.get_until() - _period.get_from() + std::chrono::days{ 1 }, GregorianCycle).count()) },
+		_cycle_non_business_days{ 0uz }
+	{
+		// the full calendars are only needed while we compress them
+
+		auto periodic_rules = annual_holiday_storage{};
+		for (const auto& rule : rules)
+			if (_is_periodic(*rule, p.get_from()))
+				periodic_rules.push_back(rule);
+
+		const auto make_full_calendar = [&](const annual_holiday_storage& rs)
+		{
+			auto cal = calendar{ _we, make_holiday_schedule(p, rs) };
+			if (substitution)
+				cal.substitute(*substitution);
+
+			return cal;
+		};
+
+		const auto periodic = make_full_calendar(periodic_rules);
+
+		auto hols = make_full_calendar(rules).get_schedule();
+		for (const auto& h : one_off_holidays)
+		{
+			if (std::chrono::sys_days{ h } < _period.get_from() || std::chrono::sys_days{ h } > _period.get_until())
+				throw std::out_of_range{ "Request is not consistent with from/until" };
+
+			hols += h;
+		}
+
+		const auto actual = calendar{ _we, std::move(hols) };
+
+		for (
+			auto d = _period.get_from();
+			d < _period.get_from() + std::chrono::days{ _cycle_length };
+			d += std::chrono::days{ 1 }
+		)
+			_cycle[d] = periodic.is_non_business_day(d);
+
+		_cycle.build_rank_index();
+		_cycle_non_business_days = _cycle.count(_cycle.get_period());
+
+		for (auto d = _period.get_from(); d <= _period.get_until(); d += std::chrono::days{ 1 })
+		{
+			const auto offset = static_cast<std::size_t>((d - _period.get_from()).count());
+			const auto in_cycle = _cycle[_period.get_from() + std::chrono::days{ offset % _cycle_length }];
+			const auto in_actual = actual.is_non_business_day(d);
+
+			if (in_actual && !in_cycle)
+				_added.push_back(d);
+			else if (!in_actual && in_cycle)
+				_removed.push_back(d);
+		}
+	}
+
+
+	inline auto compressed_calendar::is_non_business_day(const std::chrono::year_month_day& ymd) const -> bool
+	{
+		return is_non_business_day(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto compressed_calendar::is_non_business_day(const std::chrono::sys_days& sd) const -> bool
+	{
+		_check(sd);
+
+		const auto offset = static_cast<std::size_t>((sd - _period.get_from()).count());
+		const auto in_cycle = _cycle.get_unchecked(_period.get_from() + std::chrono::days{ offset % _cycle_length });
+
+		if (in_cycle)
+			return !std::ranges::binary_search(_removed, sd);
+		else
+			return std::ranges::binary_search(_added, sd);
+	}
+
+	inline auto compressed_calendar::is_business_day(const std::chrono::year_month_day& ymd) const -> bool
+	{
+		return !is_non_business_day(ymd);
+	}
+
+	inline auto compressed_calendar::is_business_day(const std::chrono::sys_days& sd) const -> bool
+	{
+		return !is_non_business_day(sd);
+	}
+
+	inline auto compressed_calendar::count_business_days(const util::days_period& p) const -> std::size_t
+	{
+		return count_business_days(util::period<std::chrono::sys_days>{ p.get_from(), p.get_until() });
+	}
+
+	inline auto compressed_calendar::count_business_days(const util::period<std::chrono::sys_days>& p) const -> std::size_t
+	{
+		_check(p.get_from());
+		_check(p.get_until());
+
+		const auto from_offset = static_cast<std::size_t>((p.get_from() - _period.get_from()).count());
+		const auto until_offset = static_cast<std::size_t>((p.get_until() - _period.get_from()).count());
+
+		const auto in_period = [&p](const auto& ds)
+		{
+			const auto first = std::ranges::lower_bound(ds, p.get_from());
+			const auto last = std::ranges::upper_bound(ds, p.get_until());
+			return static_cast<std::size_t>(last - first);
+		};
+
+		const auto non_business_days =
+			_cycle_rank(until_offset + 1uz) - _cycle_rank(from_offset) + in_period(_added) - in_period(_removed);
+
+		return until_offset - from_offset + 1uz - non_business_days;
+	}
+
+
+	inline auto compressed_calendar::make_calendar(const util::days_period& p) const -> calendar
+	{
+		auto hols = schedule::dates{};
+		for (auto d = std::chrono::sys_days{ p.get_from() }; d <= std::chrono::sys_days{ p.get_until() }; d += std::chrono::days{ 1 })
+			if (is_non_business_day(d) && !_we.is_weekend(d))
+				hols.insert(hols.end(), std::chrono::year_month_day{ d });
+
+		return calendar{ _we, schedule{ p, std::move(hols) } };
+	}
+
+
+	inline auto compressed_calendar::get_weekend() const noexcept -> const weekend&
+	{
+		return _we;
+	}
+
+	inline auto compressed_calendar::get_period() const noexcept -> util::days_period
+	{
+		return util::days_period{ _period.get_from(), _period.get_until() };
+	}
+
+	inline auto compressed_calendar::get_exceptions_size() const noexcept -> std::size_t
+	{
+		return _added.size() + _removed.size();
+	}
+
+
+	inline auto compressed_calendar::_cycle_rank(const std::size_t offset) const -> std::size_t
+	{
+		const auto cycles = offset / _cycle_length;
+		const auto rest = offset % _cycle_length;
+
+		return cycles * _cycle_non_business_days + _cycle.rank(_period.get_from() + std::chrono::days{ rest }, true);
+	}
+
+	inline void compressed_calendar::_check(const std::chrono::sys_days& sd) const
+	{
+		if (sd < _period.get_from() || sd > _period.get_until())
+			throw std::out_of_range{ "Request is not consistent with from/until" };
+	}
+
+}
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "annual_holiday_interface.h"
+#include "anchor_tables.h"
 
 #include <chrono>
 #include <numbers>
@@ -31,7 +32,7 @@
 #include <ranges>
 
 
-namespace gregorian // we can replace these with just a lookup table for the Epoch at least (if we want things to be constexpr and as std::cos is not yet constexpr)
+namespace gregorian // within anchor tables these are just looked up (so they are constexpr there, as std::cos is not yet constexpr), the formulas are used outside of them
 {
 
 	// from "Astronomical Algorithms" second edition 1998
@@ -47,7 +48,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 
 	private:
 
-		auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
 
 //	private:
 //
@@ -56,7 +57,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 	};
 
 
-	inline const auto MarchEquinox = vernal_equinox{}; // should be constexpr
+	inline constexpr auto MarchEquinox = vernal_equinox{};
 
 
 
@@ -69,7 +70,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 
 	private:
 
-		auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
 
 //	private:
 //
@@ -78,7 +79,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 	};
 
 
-	inline const auto JuneSolstice = summer_solstice{};
+	inline constexpr auto JuneSolstice = summer_solstice{};
 
 
 
@@ -91,7 +92,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 
 	private:
 
-		auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
 
 //	private:
 //
@@ -100,7 +101,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 	};
 
 
-	inline const auto SeptemberEquinox = autumnal_equinox{};
+	inline constexpr auto SeptemberEquinox = autumnal_equinox{};
 
 
 
@@ -113,7 +114,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 
 	private:
 
-		auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+		constexpr auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
 
 //	private:
 //
@@ -122,7 +123,7 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 	};
 
 
-	inline const auto DecemberSolstice = winter_solstice{};
+	inline constexpr auto DecemberSolstice = winter_solstice{};
 
 
 
@@ -378,30 +379,62 @@ namespace gregorian // we can replace these with just a lookup table for the Epo
 
 
 
-	inline auto vernal_equinox::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	inline auto _calculate_March_Equinox(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
 	{
 		return _equinox_solstice<2'451'623.80984, 365'242.37404, 0.05169, -0.00411, -0.00057>(y);
 	}
 
+	inline constexpr auto vernal_equinox::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return { y, std::chrono::March, std::chrono::day{ _March_Equinox_days[_anchor_table_index(y)] } };
+		else
+			return _calculate_March_Equinox(y);
+	}
+
 
 
-	inline auto summer_solstice::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	inline auto _calculate_June_Solstice(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
 	{
 		return _equinox_solstice<2'451'716.56767, 365241.62603, 0.00325, 0.00888, -0.00030>(y);
 	}
 
+	inline constexpr auto summer_solstice::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return { y, std::chrono::June, std::chrono::day{ _June_Solstice_days[_anchor_table_index(y)] } };
+		else
+			return _calculate_June_Solstice(y);
+	}
+
 
 
-	inline auto autumnal_equinox::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	inline auto _calculate_September_Equinox(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
 	{
 		return _equinox_solstice<2'451'810.21715, 365'242.01767, -0.11575, 0.00337, 0.00078>(y);
 	}
 
+	inline constexpr auto autumnal_equinox::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return { y, std::chrono::September, std::chrono::day{ _September_Equinox_days[_anchor_table_index(y)] } };
+		else
+			return _calculate_September_Equinox(y);
+	}
+
 
 
-	inline auto winter_solstice::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	inline auto _calculate_December_Solstice(const std::chrono::year& y) noexcept -> std::chrono::year_month_day
 	{
 		return _equinox_solstice<2'451'900.05952, 365'242.74049, -0.06223, -0.00823, 0.00032>(y);
 	}
 
+	inline constexpr auto winter_solstice::_make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day
+	{
+		if (_in_anchor_tables(y))
+			return { y, std::chrono::December, std::chrono::day{ _December_Solstice_days[_anchor_table_index(y)] } };
+		else
+			return _calculate_December_Solstice(y);
+	}
+
 }
@@ -24,16 +24,30 @@
 
 #include <period.h>
 #include <intersect_flat_sets.h>
+#include <unite_flat_sets.h>
+#include <eytzinger_set.h>
 
 #include <chrono>
 #include <utility>
 #include <flat_set>
+#include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
 #include <algorithm>
 #include <compare>
+#include <stdexcept>
+#include <cstdint>
 
 #define SCHEDULE_YEAR_MONTH_DAY_BASED
 //#undef SCHEDULE_YEAR_MONTH_DAY_BASED
 
+// dates are also kept as 32 bit day serials in Eytzinger order, so contains does not compare civil dates
+// (it is only built when a schedule is made as a whole, i.e. by the constructors, make_schedule, +, | and &,
+// adding or removing a single date drops it and contains goes back to the dates until the next one is made)
+#define SCHEDULE_DAY_SERIAL_INDEXED
+#undef SCHEDULE_DAY_SERIAL_INDEXED
+
 
 
 namespace gregorian
@@ -66,16 +80,38 @@ namespace gregorian
 			dates ds
 		);
 
+		// dates which are already sorted and unique, as days since 1970-01-01 (e.g. mapped from a calendar database
+		// or made at compile time), are referred to rather than copied (owner keeps them alive, if they are not static)
+		// contains looks them up as they are, they are only made into dates by get_dates or by a change to the schedule
+		// (and the serial index, if any, is not built for them)
+		schedule(
+			util::days_period p,
+			std::sorted_unique_t,
+			std::span<const std::int32_t> serials,
+			std::shared_ptr<const void> owner
+		);
+
 	public:
 
 		friend auto operator+(schedule s1, schedule s2) -> schedule; // is it still the right interface? (also for | and &)
 			
 		auto operator+=(schedule s) -> schedule&;
 
+		// a schedule which refers to its dates makes them its own first
 		auto operator+=(const std::chrono::year_month_day& ymd) -> schedule&;
 		auto operator-=(const std::chrono::year_month_day& ymd) noexcept -> schedule&;
 
-		[[nodiscard]] friend auto operator==(const schedule& s1, const schedule& s2) noexcept -> bool = default;
+		[[nodiscard]] friend auto operator==(const schedule& s1, const schedule& s2) noexcept -> bool // the index is not compared
+		{
+			if (s1._period != s2._period)
+				return false;
+
+			if (s1._view && s2._view)
+				return std::ranges::equal(s1._view->serials, s2._view->serials);
+
+			return s1.get_dates() == s2.get_dates();
+		}
+
 		[[nodiscard]] friend auto operator<=>(const schedule& s1, const schedule& s2) noexcept -> std::strong_ordering = delete;
 
 		friend auto operator|(schedule s1, schedule s2) -> schedule;
@@ -91,17 +127,41 @@ namespace gregorian
 
 		[[nodiscard]] auto get_period() const noexcept -> const util::days_period&;
 
+		// dates which are referred to are made into dates the first time they are asked for
 		[[nodiscard]] auto get_dates() const noexcept -> const dates&;
 
 	private:
 
 		void _trim();
 
+		void _own();
+
+		void _index();
+
+		void _drop_index() noexcept;
+
+	private:
+
+		struct _serial_view final
+		{
+			std::span<const std::int32_t> serials;
+			std::shared_ptr<const void> owner;
+
+			std::once_flag made;
+			dates ds; // made from the serials (once)
+		};
+
 	private:
 
 		util::days_period _period;
 
-		dates _dates;
+		dates _dates; // not used if the dates are referred to
+
+		std::shared_ptr<_serial_view> _view; // shared by copies, so the dates are only made once for all of them
+
+#ifdef SCHEDULE_DAY_SERIAL_INDEXED
+		util::eytzinger_set<std::int32_t> _serials;
+#endif
 
 	};
 
@@ -109,8 +169,7 @@ namespace gregorian
 
 	[[nodiscard]] inline auto operator|(schedule s1, schedule s2) -> schedule
 	{
-		auto& ds = s1._dates;
-		ds.insert_range(s2._dates); // there might be a faster way to do this
+		auto ds = util::unite_flat_sets(s1.get_dates(), s2.get_dates());
 
 		return schedule{
 			s1.get_period() | s2.get_period(),
@@ -118,9 +177,56 @@ namespace gregorian
 		};
 	}
 
+	// the same as | of all of them (in any order), but the dates are merged at once
+	[[nodiscard]] inline auto join(std::span<const schedule* const> ss) -> schedule
+	{
+		if (ss.empty())
+			throw std::invalid_argument{ "There should be at least one schedule to join" };
+
+		auto ps = std::vector<util::days_period>{};
+		ps.reserve(ss.size());
+		auto dss = std::vector<const schedule::dates*>{};
+		dss.reserve(ss.size());
+		for (const auto* s : ss)
+		{
+			ps.push_back(s->get_period());
+			dss.push_back(&s->get_dates());
+		}
+
+		// in the order of from, so that gaps are only between periods which do not overlap any other
+		std::ranges::sort(ps, {}, &util::days_period::get_from);
+		auto p = ps.front();
+		for (const auto& q : ps)
+			p = p | q;
+
+		return schedule{
+			std::move(p),
+			util::unite_flat_sets(std::span<const schedule::dates* const>{ dss })
+		};
+	}
+
+	// dates in any order, with duplicates and invalid ones (which are skipped), are sorted at once rather than inserted one by one
+	[[nodiscard]] inline auto make_schedule(util::days_period p, std::vector<std::chrono::year_month_day> ds) -> schedule
+	{
+		std::erase_if(ds, [](const std::chrono::year_month_day& d) { return !d.ok(); });
+		std::ranges::sort(ds);
+		ds.erase(std::ranges::unique(ds).begin(), ds.end());
+
+#ifdef SCHEDULE_YEAR_MONTH_DAY_BASED
+		return schedule{ std::move(p), schedule::dates{ std::sorted_unique, std::move(ds) } };
+#else
+		auto sds = std::vector<std::chrono::sys_days>{};
+		sds.reserve(ds.size());
+		for (const auto& d : ds)
+			sds.push_back(std::chrono::sys_days{ d });
+
+		return schedule{ std::move(p), schedule::dates{ std::sorted_unique, std::move(sds) } };
+#endif
+	}
+
 	[[nodiscard]] inline auto operator&(schedule s1, schedule s2) -> schedule
 	{
-		auto ds = util::intersect_flat_sets(s1._dates, s2._dates);
+		auto ds = util::intersect_flat_sets(s1.get_dates(), s2.get_dates());
 
 		return schedule{
 			s1.get_period() & s2.get_period(),
@@ -150,8 +256,7 @@ namespace gregorian
 
 	[[nodiscard]] inline auto operator+(schedule s1, schedule s2) -> schedule
 	{
-		auto& ds = s1._dates;
-		ds.insert_range(s2._dates); // there might be a faster way to do this
+		auto ds = util::unite_flat_sets(s1.get_dates(), s2.get_dates()); // periods do not overlap, but the dates do not have to be within them
 
 		return schedule{
 			s1.get_period() + s2.get_period(),
@@ -204,6 +309,7 @@ namespace gregorian
 		_dates{ std::move(ds) }
 	{
 		_trim();
+		_index();
 	}
 
 	inline schedule::schedule(
@@ -212,6 +318,26 @@ namespace gregorian
 		_dates{ std::move(ds) }
 	{
 		_trim();
+		_index();
+	}
+
+
+	inline schedule::schedule(
+		util::days_period p,
+		std::sorted_unique_t,
+		std::span<const std::int32_t> serials,
+		std::shared_ptr<const void> owner
+	) : _period{ std::move(p) },
+		_view{ std::make_shared<_serial_view>() }
+	{
+		// only the ones within [from, until] are referred to
+		const auto from = static_cast<std::int32_t>(std::chrono::sys_days{ _period.get_from() }.time_since_epoch().count());
+		const auto until = static_cast<std::int32_t>(std::chrono::sys_days{ _period.get_until() }.time_since_epoch().count());
+		const auto first = std::ranges::lower_bound(serials, from);
+		const auto last = std::ranges::upper_bound(first, serials.end(), until);
+
+		_view->serials = std::span<const std::int32_t>{ first, last };
+		_view->owner = std::move(owner);
 	}
 
 
@@ -222,6 +348,35 @@ namespace gregorian
 		_dates.erase(std::upper_bound(_dates.cbegin(), _dates.cend(), _period.get_until()), _dates.end());
 	}
 
+	inline void schedule::_index()
+	{
+#ifdef SCHEDULE_DAY_SERIAL_INDEXED
+		auto serials = std::vector<std::int32_t>{};
+		serials.reserve(_dates.size());
+		for (const auto& d : _dates)
+			serials.push_back(static_cast<std::int32_t>(std::chrono::sys_days{ d }.time_since_epoch().count()));
+
+		_serials = util::eytzinger_set<std::int32_t>{ serials };
+#endif
+	}
+
+
+	inline void schedule::_own()
+	{
+		if (!_view)
+			return;
+
+		_dates = get_dates();
+		_view.reset();
+	}
+
+	inline void schedule::_drop_index() noexcept
+	{
+#ifdef SCHEDULE_DAY_SERIAL_INDEXED
+		_serials = util::eytzinger_set<std::int32_t>{};
+#endif
+	}
+
 
 	inline auto schedule::operator+=(schedule s) -> schedule&
 	{
@@ -232,30 +387,73 @@ namespace gregorian
 
 	inline auto schedule::operator+=(const std::chrono::year_month_day& ymd) -> schedule&
 	{
-		if(_period.contains(ymd))
-			_dates.insert(ymd);
+		if (!_period.contains(ymd) || contains(ymd))
+			return *this;
+
+		_own();
+		_dates.insert(ymd);
+		_drop_index();
 
 		return *this;
 	}
 
 	inline auto schedule::operator-=(const std::chrono::year_month_day& ymd) noexcept -> schedule&
 	{
+		if (!contains(ymd))
+			return *this;
+
+		_own();
 		_dates.erase(ymd);
+		_drop_index();
 
 		return *this;
 	}
 
 
+#ifdef SCHEDULE_DAY_SERIAL_INDEXED
+
 	inline auto schedule::contains(const std::chrono::year_month_day& ymd) const noexcept -> bool
 	{
+		if (_view)
+			return contains(std::chrono::sys_days{ ymd });
+
+		if (_serials.size() != _dates.size()) // dropped
+			return _dates.contains(ymd);
+
+		return contains(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto schedule::contains(const std::chrono::sys_days& sd) const noexcept -> bool
+	{
+		if (_view)
+			return std::ranges::binary_search(_view->serials, static_cast<std::int32_t>(sd.time_since_epoch().count()));
+
+		if (_serials.size() != _dates.size()) // dropped
+			return _dates.contains(sd);
+
+		return _serials.contains(static_cast<std::int32_t>(sd.time_since_epoch().count()));
+	}
+
+#else
+
+	inline auto schedule::contains(const std::chrono::year_month_day& ymd) const noexcept -> bool
+	{
+		if (_view)
+			return contains(std::chrono::sys_days{ ymd });
+
 		return _dates.contains(ymd);
 	}
 
 	inline auto schedule::contains(const std::chrono::sys_days& sd) const noexcept -> bool
 	{
+		if (_view)
+			return std::ranges::binary_search(_view->serials, static_cast<std::int32_t>(sd.time_since_epoch().count()));
+
 		return contains(std::chrono::year_month_day{ sd });
 	}
 
+#endif
+
 	inline auto schedule::get_period() const noexcept -> const util::days_period&
 	{
 		return _period;
@@ -263,7 +461,23 @@ namespace gregorian
 
 	inline auto schedule::get_dates() const noexcept -> const dates&
 	{
-		return _dates;
+		if (!_view)
+			return _dates;
+
+		std::call_once(
+			_view->made,
+			[this]()
+			{
+				auto ds = std::vector<dates::value_type>{};
+				ds.reserve(_view->serials.size());
+				for (const auto serial : _view->serials)
+					ds.emplace_back(std::chrono::sys_days{ std::chrono::days{ serial } });
+
+				_view->ds = dates{ std::sorted_unique, std::move(ds) };
+			}
+		);
+
+		return _view->ds;
 	}
 
 }
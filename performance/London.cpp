@@ -166,3 +166,41 @@ auto make_London_calendar() -> const calendar&
 	static const auto s = _make_London_calendar();
 	return s;
 }
+
+
+
+static auto _make_London_Epoch_calendar() -> calendar
+{
+	// same as static_data::Epoch (we do not link static_data here)
+	const auto Epoch = years_period{ year{ 2012 }, year{ 2112 } };
+
+	const auto EarlyMayBankHoliday = weekday_indexed_holiday{ May / Monday[1] };
+	const auto SpringBankHoliday = weekday_last_holiday{ May / Monday[last] };
+	const auto SummerBankHoliday = weekday_last_holiday{ August / Monday[last] };
+
+	const auto rules = annual_holiday_storage{
+		&NewYearsDay,
+		&GoodFriday,
+		&EasterMonday,
+		&EarlyMayBankHoliday,
+		&SpringBankHoliday,
+		&SummerBankHoliday,
+		&ChristmasDay,
+		&BoxingDay
+	};
+
+	auto cal = calendar{
+		SaturdaySundayWeekend,
+		make_holiday_schedule(Epoch, rules)
+	};
+	cal.substitute(Following);
+
+	return cal;
+}
+
+
+auto make_London_Epoch_calendar() -> const calendar&
+{
+	static const auto s = _make_London_Epoch_calendar();
+	return s;
+}
@@ -27,3 +27,6 @@
 
 
 auto make_London_calendar() -> const gregorian::calendar&;
+
+// London rules over the whole of static_data's Epoch (2012 - 2112)
+auto make_London_Epoch_calendar() -> const gregorian::calendar&;
@@ -23,13 +23,24 @@
 #include "London.h"
 
 #include <calendar.h>
+#include <calendar_algorithms.h>
+#include <business_day_adjusters.h>
 #include <period.h>
+#include <time_series.h>
+#include <popcount.h>
+#include <intersect_flat_sets.h>
 
 #include <chrono>
 #include <string>
 #include <iostream>
 #include <algorithm>
 #include <atomic>
+#include <vector>
+#include <span>
+#include <memory>
+#include <flat_set>
+#include <optional>
+#include <cstdint>
 
 using namespace std;
 using namespace std::chrono;
@@ -136,6 +147,100 @@ static void experiment_is_business_day_sys_days()
 }
 
 
+static void experiment_is_business_day_unchecked()
+{
+	const auto& calendar = make_London_calendar();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now(); // maybe it is not fair to use atomic here
+
+		auto number_of_business_days = atomic<int>{ 0 };
+		for (
+			auto d = sys_days{ SONIA_compound_index_from };
+			d <= sys_days{ until };
+			d += days{ 1 }
+		)
+			if (calendar.is_business_day_unchecked(d)) // the range is known to be within the calendar
+				number_of_business_days++;
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+static void experiment_is_business_day_batch()
+{
+	const auto& calendar = make_London_calendar();
+
+	auto sds = vector<sys_days>{};
+	for (
+		auto d = sys_days{ SONIA_compound_index_from };
+		d <= sys_days{ until };
+		d += days{ 1 }
+	)
+		sds.push_back(d);
+
+	auto out = make_unique<bool[]>(sds.size());
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		calendar.is_business_day(sds, span{ out.get(), sds.size() });
+		const auto number_of_business_days = count(out.get(), out.get() + sds.size(), true);
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
 static void experiment_count_business_days_year_month_day()
 {
 	const auto& calendar = make_London_calendar();
@@ -216,6 +321,373 @@ static void experiment_count_business_sys_days()
 }
 
 
+// calendar builds the rank index (once it is fully populated), so we copy its non business days to see the difference
+static auto _make_non_business_days(const calendar& cal, const bool with_rank_index) -> time_series<bool>
+{
+	const auto& p = cal.get_schedule().get_period();
+
+	auto ts = time_series<bool>{ p };
+	for (
+		auto d = sys_days{ p.get_from() };
+		d <= sys_days{ p.get_until() };
+		d += days{ 1 }
+	)
+		ts[d] = cal.is_non_business_day(d);
+
+	if (with_rank_index)
+		ts.build_rank_index();
+
+	return ts;
+}
+
+
+static void experiment_count_periods(const days& length, const bool with_rank_index)
+{
+	const auto& calendar = make_London_calendar();
+	const auto non_business_days = _make_non_business_days(calendar, with_rank_index);
+
+	const auto& cp = calendar.get_schedule().get_period();
+	const auto from = sys_days{ cp.get_from() };
+	const auto until = sys_days{ cp.get_until() } - length;
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto number_of_non_business_days = atomic<size_t>{ 0uz }; // maybe it is not fair to use atomic here
+		for (
+			auto d = from;
+			d <= until;
+			d += days{ 1 }
+		)
+			number_of_non_business_days += non_business_days.count(period{ d, d + length });
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+// the same as above, but for a given chunk size (and over every period of a given length within any calendar)
+template<size_t chunk_size>
+static void experiment_count_periods_chunk_size(const calendar& cal, const days& length, const bool with_rank_index)
+{
+	const auto& cp = cal.get_schedule().get_period();
+	const auto from = sys_days{ cp.get_from() };
+	const auto until = sys_days{ cp.get_until() } - length;
+
+	auto non_business_days = time_series<bool, chunk_size>{ cp };
+	for (auto d = from; d <= sys_days{ cp.get_until() }; d += days{ 1 })
+		non_business_days[d] = cal.is_non_business_day(d);
+
+	if (with_rank_index)
+		non_business_days.build_rank_index();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto number_of_non_business_days = atomic<size_t>{ 0uz }; // maybe it is not fair to use atomic here
+		for (
+			auto d = from;
+			d <= until;
+			d += days{ 1 }
+		)
+			number_of_non_business_days += non_business_days.count(period{ d, d + length });
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Chunk size: "s
+		<< chunk_size
+		<< (with_rank_index ? " with rank index"s : " without rank index"s)
+		<< ", duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+static void experiment_count_periods_chunk_sizes(const calendar& cal, const days& length)
+{
+	for (const auto with_rank_index : { false, true })
+	{
+		experiment_count_periods_chunk_size<64uz>(cal, length, with_rank_index);
+		experiment_count_periods_chunk_size<128uz>(cal, length, with_rank_index);
+		experiment_count_periods_chunk_size<256uz>(cal, length, with_rank_index);
+		experiment_count_periods_chunk_size<512uz>(cal, length, with_rank_index);
+	}
+}
+
+
+static void experiment_shift_business_days(const days& n)
+{
+	const auto& calendar = make_London_calendar();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto last_shifted = atomic<sys_days>{}; // maybe it is not fair to use atomic here
+		for (
+			auto d = sys_days{ SONIA_compound_index_from } + days{ 366 }; // leave room to shift backwards
+			d <= sys_days{ until };
+			d += days{ 1 }
+		)
+			last_shifted = shift_business_days(d, n, calendar);
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+// adjust is called as adjust(d, calendar), so the same loop runs with static and with virtual dispatch
+static void experiment_adjust(const auto& adjust)
+{
+	const auto& calendar = make_London_calendar();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto last_adjusted = atomic<sys_days>{}; // maybe it is not fair to use atomic here
+		for (
+			auto d = sys_days{ SONIA_compound_index_from };
+			d <= sys_days{ until };
+			d += days{ 1 }
+		)
+			last_adjusted = adjust(d, calendar);
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+// contains for every day of a 100 year schedule with the dates stored as with both SCHEDULE_YEAR_MONTH_DAY_BASED settings
+// (flat_set of year/month/day or of sys_days) and by the schedule itself (day serials in Eytzinger order, if indexed)
+template<typename Contains>
+static void experiment_schedule_contains(const Contains& contains)
+{
+	const auto& p = make_London_Epoch_calendar().get_schedule().get_period();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto found = atomic<size_t>{}; // maybe it is not fair to use atomic here
+		auto n = 0uz;
+		for (
+			auto d = sys_days{ p.get_from() };
+			d <= sys_days{ p.get_until() };
+			d += days{ 1 }
+		)
+			n += contains(d) ? 1uz : 0uz;
+		found = n;
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Found: "s
+			<< found
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+// a service which only looks at the SONIA period of a 100 year calendar
+static void experiment_make_calendar(const calendar::caching c)
+{
+	const auto& cal = make_London_Epoch_calendar();
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto business_days = atomic<size_t>{}; // maybe it is not fair to use atomic here
+		for (auto i = 0; i < 100; ++i)
+		{
+			const auto made = calendar{ cal.get_weekend(), cal.get_schedule(), c };
+			business_days = made.count_business_days(period{ sys_days{ SONIA_compound_index_from }, sys_days{ until } });
+		}
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+		cout
+			<< "Run:"s
+			<< r
+			<< " Duration: "s
+			<< duration.count()
+			<< " microseconds."s
+			<< endl;
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
+// intersection of the day serials of every ratio-th day of 100 years with the day serials of every day of a longer period
+// (so that the smaller set is about 1/ratio of the larger one and most of its days are found)
+static void experiment_intersect_flat_sets(const size_t ratio, const optional<intersect_kernel> k)
+{
+	const auto& p = make_London_Epoch_calendar().get_schedule().get_period();
+	const auto from = static_cast<int32_t>(sys_days{ p.get_from() }.time_since_epoch().count());
+	const auto until = static_cast<int32_t>(sys_days{ p.get_until() }.time_since_epoch().count());
+
+	auto large = vector<int32_t>{};
+	auto small = vector<int32_t>{};
+	for (auto d = from; d <= until; ++d)
+	{
+		large.push_back(d);
+		if (static_cast<size_t>(d - from) % ratio == 0uz)
+			small.push_back(d + 1); // so that the last one may be missing
+	}
+
+	const auto l = flat_set<int32_t>{ sorted_unique, std::move(large) };
+	const auto s = flat_set<int32_t>{ sorted_unique, std::move(small) };
+
+	auto min_duration = microseconds::max();
+	auto max_duration = microseconds::min();
+
+	for (auto r = 0; r < number_of_runs; ++r)
+	{
+		const auto start = high_resolution_clock::now();
+
+		auto found = atomic<size_t>{}; // maybe it is not fair to use atomic here
+		for (auto i = 0; i < 100; ++i)
+			found = (k ? intersect_flat_sets(s, l, *k) : intersect_flat_sets(s, l)).size();
+
+		const auto stop = high_resolution_clock::now();
+
+		const auto duration = duration_cast<microseconds>(stop - start);
+
+		min_duration = min(duration, min_duration);
+		max_duration = max(duration, max_duration);
+	}
+
+	cout
+		<< "Ratio: "s
+		<< ratio
+		<< " Duration range: ["s
+		<< min_duration.count()
+		<< ", "s
+		<< max_duration.count()
+		<< "] microseconds."s
+		<< endl;
+}
+
+
 int main()
 {
 	cout << "Experiment is_business_day with year/month/day:"s << endl;
@@ -226,6 +698,14 @@ int main()
 	experiment_is_business_day_sys_days();
 	cout << endl;
 
+	cout << "Experiment is_business_day_unchecked with sys_days:"s << endl;
+	experiment_is_business_day_unchecked();
+	cout << endl;
+
+	cout << "Experiment is_business_day over a batch of sys_days:"s << endl;
+	experiment_is_business_day_batch();
+	cout << endl;
+
 	cout << "Experiment count_business_days with year/month/day:"s << endl;
 	experiment_count_business_days_year_month_day();
 	cout << endl;
@@ -234,5 +714,125 @@ int main()
 	experiment_count_business_sys_days();
 	cout << endl;
 
+	// every period of a given length within the calendar (so both are sensitive to per call overhead)
+
+	cout << "Experiment count over short (1 month) periods without rank index:"s << endl;
+	experiment_count_periods(days{ 30 }, false);
+	cout << endl;
+
+	cout << "Experiment count over short (1 month) periods with rank index:"s << endl;
+	experiment_count_periods(days{ 30 }, true);
+	cout << endl;
+
+	cout << "Experiment count over long (10 years) periods without rank index:"s << endl;
+	experiment_count_periods(days{ 3652 }, false);
+	cout << endl;
+
+	cout << "Experiment count over long (10 years) periods with rank index:"s << endl;
+	experiment_count_periods(days{ 3652 }, true);
+	cout << endl;
+
+	// popcount kernel is picked at runtime (scalar/AVX2/AVX-512), so results depend on the CPU
+	cout << "Popcount kernel: "s << static_cast<int>(get_popcount_kernel()) << endl;
+	cout << endl;
+
+	cout << "Experiment count over long (10 years) periods by chunk size (London):"s << endl;
+	experiment_count_periods_chunk_sizes(make_London_calendar(), days{ 3652 });
+	cout << endl;
+
+	cout << "Experiment count over long (10 years) periods by chunk size (London over the full Epoch):"s << endl;
+	experiment_count_periods_chunk_sizes(make_London_Epoch_calendar(), days{ 3652 });
+	cout << endl;
+
+	cout << "Experiment count over very long (50 years) periods by chunk size (London over the full Epoch):"s << endl;
+	experiment_count_periods_chunk_sizes(make_London_Epoch_calendar(), days{ 18262 });
+	cout << endl;
+
+	// shift by rank/select should not depend on the number of business days to shift by
+
+	cout << "Experiment shift_business_days by 1 business day:"s << endl;
+	experiment_shift_business_days(days{ 1 });
+	cout << endl;
+
+	cout << "Experiment shift_business_days by 252 business days:"s << endl;
+	experiment_shift_business_days(days{ 252 });
+	cout << endl;
+
+	cout << "Experiment shift_business_days by -252 business days:"s << endl;
+	experiment_shift_business_days(days{ -252 });
+	cout << endl;
+
+	cout << "Experiment adjust with Following:"s << endl;
+	experiment_adjust([](const sys_days& d, const calendar& cal) { return Following.adjust(d, cal); });
+	cout << endl;
+
+	cout << "Experiment adjust with Following (through business_day_adjuster&):"s << endl;
+	const business_day_adjuster& following_adjuster = Following;
+	experiment_adjust([&following_adjuster](const sys_days& d, const calendar& cal) { return following_adjuster.adjust(d, cal); });
+	cout << endl;
+
+	cout << "Experiment adjust with business_day_convention::following:"s << endl;
+	const auto convention = business_day_convention::following;
+	experiment_adjust([convention](const sys_days& d, const calendar& cal) { return adjust(d, convention, cal); });
+	cout << endl;
+
+	cout << "Experiment adjust with Preceding:"s << endl;
+	experiment_adjust([](const sys_days& d, const calendar& cal) { return Preceding.adjust(d, cal); });
+	cout << endl;
+
+	cout << "Experiment adjust with Nearest:"s << endl;
+	experiment_adjust([](const sys_days& d, const calendar& cal) { return Nearest.adjust(d, cal); });
+	cout << endl;
+
+	const auto& s = make_London_Epoch_calendar().get_schedule();
+
+	cout << "Experiment schedule contains with flat_set<year_month_day> (SCHEDULE_YEAR_MONTH_DAY_BASED):"s << endl;
+	const auto ymds = flat_set<year_month_day>{ s.get_dates().cbegin(), s.get_dates().cend() };
+	experiment_schedule_contains([&ymds](const sys_days& sd) { return ymds.contains(year_month_day{ sd }); });
+	cout << endl;
+
+	cout << "Experiment schedule contains with flat_set<sys_days> (no SCHEDULE_YEAR_MONTH_DAY_BASED):"s << endl;
+	const auto sds = flat_set<sys_days>{ s.get_dates().cbegin(), s.get_dates().cend() };
+	experiment_schedule_contains([&sds](const sys_days& sd) { return sds.contains(sd); });
+	cout << endl;
+
+	cout << "Experiment schedule contains (as built):"s << endl;
+	experiment_schedule_contains([&s](const sys_days& sd) { return s.contains(sd); });
+	cout << endl;
+
+	// 100 calendars over the full Epoch, each used for the SONIA period only
+
+	cout << "Experiment make calendar (eager) and count business days:"s << endl;
+	experiment_make_calendar(calendar::caching::eager);
+	cout << endl;
+
+	cout << "Experiment make calendar (lazy) and count business days:"s << endl;
+	experiment_make_calendar(calendar::caching::lazy);
+	cout << endl;
+
+	// 100 intersections for each ratio of the sizes
+
+	const auto ratios = { 1uz, 2uz, 4uz, 8uz, 16uz, 64uz, 256uz, 1024uz };
+
+	cout << "Experiment intersect_flat_sets (linear):"s << endl;
+	for (const auto ratio : ratios)
+		experiment_intersect_flat_sets(ratio, intersect_kernel::linear);
+	cout << endl;
+
+	cout << "Experiment intersect_flat_sets (galloping):"s << endl;
+	for (const auto ratio : ratios)
+		experiment_intersect_flat_sets(ratio, intersect_kernel::galloping);
+	cout << endl;
+
+	cout << "Experiment intersect_flat_sets (simd):"s << endl;
+	for (const auto ratio : ratios)
+		experiment_intersect_flat_sets(ratio, intersect_kernel::simd);
+	cout << endl;
+
+	cout << "Experiment intersect_flat_sets (adaptive):"s << endl;
+	for (const auto ratio : ratios)
+		experiment_intersect_flat_sets(ratio, nullopt);
+	cout << endl;
+
 	return 0;
 }
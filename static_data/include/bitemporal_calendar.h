@@ -0,0 +1,212 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <period.h>
+#include <time_series.h>
+#include <calendar.h>
+
+#include "static_data.h"
+
+#include <chrono>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <execution>
+#include <type_traits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		// "was a day a business day as known on an as of date" (e.g. for backtesting) across all versions of a calendar
+		// versions differ by a handful of days, so these days are indexed (with whether they are business days in each version)
+		// and any other day within the period common to all the versions is looked up in the latest version,
+		// rather than a version being located per day (days outside the common period go to their version)
+		// the index is built upfront (comparing the versions populates them), it is valid for as long as the calendars of the handle
+		class bitemporal_calendar final
+		{
+
+		public:
+
+			explicit bitemporal_calendar(calendar_handle h);
+
+		public:
+
+			[[nodiscard]] auto get_name() const noexcept -> std::string_view;
+
+			// days of the period common to all the versions which are not the same in all of them (in order)
+			[[nodiscard]] auto get_changed_days() const noexcept -> std::span<const std::chrono::sys_days>;
+
+		public:
+
+			// throw std::runtime_error if there is no version as of as_of_date (like calendar_handle::locate)
+			// and std::out_of_range if the day (or the period) is not within the version
+			[[nodiscard]] auto is_business_day(const std::chrono::sys_days& sd, const std::chrono::year_month_day& as_of_date) const -> bool;
+
+			[[nodiscard]] auto count_business_days(const util::period<std::chrono::sys_days>& p, const std::chrono::year_month_day& as_of_date) const -> std::size_t;
+
+		public:
+
+			// batch versions of the above (for a whole backtest at once), i-th day (or period) is as known on i-th as of date
+			// all the inputs are checked before anything is written to out (which has to be of the same size),
+			// so with std::execution::par the per-pair work does not throw
+
+			void is_business_day(
+				std::span<const std::chrono::sys_days> sds,
+				std::span<const std::chrono::year_month_day> as_of_dates,
+				std::span<bool> out
+			) const;
+
+			template<typename ExecutionPolicy>
+				requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+			void is_business_day(
+				ExecutionPolicy&& policy,
+				std::span<const std::chrono::sys_days> sds,
+				std::span<const std::chrono::year_month_day> as_of_dates,
+				std::span<bool> out
+			) const;
+
+			void count_business_days(
+				std::span<const util::period<std::chrono::sys_days>> ps,
+				std::span<const std::chrono::year_month_day> as_of_dates,
+				std::span<std::size_t> out
+			) const;
+
+			template<typename ExecutionPolicy>
+				requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+			void count_business_days(
+				ExecutionPolicy&& policy,
+				std::span<const util::period<std::chrono::sys_days>> ps,
+				std::span<const std::chrono::year_month_day> as_of_dates,
+				std::span<std::size_t> out
+			) const;
+
+		private:
+
+			// index of the version as of as_of_date (throws if there is none)
+			auto _locate(const std::chrono::year_month_day& as_of_date) const -> std::size_t;
+
+			// the same, but number of versions if there is none
+			auto _find(const std::chrono::year_month_day& as_of_date) const noexcept -> std::size_t;
+
+			// the day (or the period) has to be within the version
+			auto _is_business_day(const std::chrono::sys_days& sd, const std::size_t version) const noexcept -> bool;
+
+			auto _count_business_days(const util::period<std::chrono::sys_days>& p, const std::size_t version) const noexcept -> std::size_t;
+
+			// whether i-th changed day is a business day in the version
+			auto _is_changed_business_day(const std::size_t i, const std::size_t version) const noexcept -> bool;
+
+			template<typename T>
+			void _check(std::span<const T> xs, std::span<const std::chrono::year_month_day> as_of_dates, const std::size_t out_size) const;
+
+		private:
+
+			calendar_handle _handle;
+
+			std::vector<std::chrono::year_month_day> _as_of_dates; // in order
+			std::vector<const calendar*> _calendars; // in the same order
+			std::vector<util::period<std::chrono::sys_days>> _periods; // of the above
+
+			std::optional<util::period<std::chrono::sys_days>> _common; // common to all the versions (if there is one)
+			std::optional<util::time_series<bool>> _changed; // over the common period, whether a day is not the same in all the versions
+
+			std::vector<std::chrono::sys_days> _changed_days; // in order
+			std::size_t _words_per_day{ 0uz };
+			std::vector<std::uint64_t> _business_days; // _words_per_day words per changed day, bit v is set if it is a business day in version v
+
+		};
+
+
+
+		template<typename ExecutionPolicy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+		void bitemporal_calendar::is_business_day(
+			ExecutionPolicy&& policy,
+			std::span<const std::chrono::sys_days> sds,
+			std::span<const std::chrono::year_month_day> as_of_dates,
+			std::span<bool> out
+		) const
+		{
+			_check(sds, as_of_dates, out.size());
+
+			std::transform(
+				std::forward<ExecutionPolicy>(policy),
+				sds.begin(),
+				sds.end(),
+				as_of_dates.begin(),
+				out.begin(),
+				[this](const std::chrono::sys_days& sd, const std::chrono::year_month_day& as_of_date)
+				{
+					return _is_business_day(sd, _find(as_of_date));
+				}
+			);
+		}
+
+		template<typename ExecutionPolicy>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+		void bitemporal_calendar::count_business_days(
+			ExecutionPolicy&& policy,
+			std::span<const util::period<std::chrono::sys_days>> ps,
+			std::span<const std::chrono::year_month_day> as_of_dates,
+			std::span<std::size_t> out
+		) const
+		{
+			_check(ps, as_of_dates, out.size());
+
+			std::transform(
+				std::forward<ExecutionPolicy>(policy),
+				ps.begin(),
+				ps.end(),
+				as_of_dates.begin(),
+				out.begin(),
+				[this](const util::period<std::chrono::sys_days>& p, const std::chrono::year_month_day& as_of_date)
+				{
+					return _count_business_days(p, _find(as_of_date));
+				}
+			);
+		}
+
+		template<typename T>
+		void bitemporal_calendar::_check(std::span<const T> xs, std::span<const std::chrono::year_month_day> as_of_dates, const std::size_t out_size) const
+		{
+			if (xs.size() != as_of_dates.size() || xs.size() != out_size)
+				throw std::invalid_argument{ "Input and output sizes are not consistent" };
+
+			for (auto i = 0uz; i < xs.size(); ++i)
+				if (!_periods[_locate(as_of_dates[i])].contains(xs[i]))
+					throw std::out_of_range{ "Request is not consistent with from/until" };
+		}
+
+	}
+
+}
@@ -0,0 +1,162 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <period.h>
+#include <calendar.h>
+#include <weekend.h>
+
+#include "static_data.h"
+
+#include <chrono>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		// binary calendar database (a file which many processes can map and share via the page cache)
+		//
+		// all the numbers are little endian and all the sections are aligned to their element size (pages to their size):
+		//   header:     magic, format version, number of calendars, number of versions, pages (offset, count and size in words),
+		//               size of the file
+		//   calendars:  name (offset and size), first version and number of versions - sorted by name
+		//   versions:   as of date, period, weekend, holidays (offset and count) and page references (offset and count)
+		//   names:      characters of all the names (not 0 terminated)
+		//   holidays:   days since 1970-01-01 (int32, sorted and unique)
+		//   page refs:  index of each page of non business days of a version in pages (uint32)
+		//   pages:      non business days, bit i of the pages of a version is the day i days after the start of its period
+		//               (each page is only written once, versions with the same page refer to it and so share it)
+		//
+		// days are days since 1970-01-01 (like sys_days), weekend is a mask of c_encoding weekdays
+
+		constexpr auto _calendar_db_format_version = std::uint32_t{ 2u };
+
+
+		// what write_calendar_db writes and calendar_db reads
+		struct _calendar_db_header final
+		{
+			char magic[8];
+			std::uint32_t format_version;
+			std::uint32_t calendar_count;
+			std::uint64_t version_count;
+			std::uint64_t pages_offset;
+			std::uint64_t page_count;
+			std::uint64_t page_size; // in words (the same as the one of util::time_series<bool>)
+			std::uint64_t file_size;
+		};
+
+		struct _calendar_db_calendar final
+		{
+			std::uint32_t name_offset;
+			std::uint32_t name_size;
+			std::uint32_t first_version;
+			std::uint32_t version_count;
+		};
+
+		struct _calendar_db_version final
+		{
+			std::int32_t as_of_date;
+			std::int32_t from;
+			std::int32_t until;
+			std::uint32_t weekend;
+			std::uint64_t holidays_offset;
+			std::uint64_t holiday_count;
+			std::uint64_t page_refs_offset;
+			std::uint64_t page_ref_count;
+		};
+
+
+		// writes all the versions of all the calendars (which are made, if they have not been made yet)
+		// it goes to a temporary file first, which is then renamed to path,
+		// so processes which have the old file mapped keep on using it (and never see half of a file)
+		void write_calendar_db(const std::filesystem::path& path);
+
+
+		// maps the file (read only) and checks all of it before anything is read
+		// calendars are made on first use, one by one, and refer to the mapped pages for their holidays
+		// and non business days (nothing is generated, copied or compared, versions share the pages the file says they do)
+		class calendar_db final
+		{
+
+		public:
+
+			// throws std::runtime_error if the file cannot be mapped or is not a valid calendar database
+			explicit calendar_db(const std::filesystem::path& path);
+
+			calendar_db(const calendar_db&) = delete;
+			calendar_db(calendar_db&&) = delete;
+
+			auto operator=(const calendar_db&) -> calendar_db& = delete;
+			auto operator=(calendar_db&&) -> calendar_db& = delete;
+
+			~calendar_db() noexcept;
+
+		public:
+
+			[[nodiscard]] auto get_calendar_names() const -> std::vector<std::string_view>; // in order
+
+			// the same as static_data::locate_calendar_handle and locate_calendar, but served from this database
+			// (handles are valid for as long as the database, copies of calendars keep the mapping alive)
+			[[nodiscard]] auto locate_calendar_handle(std::string_view tz_name) const -> calendar_handle;
+
+			[[nodiscard]] auto locate_calendar(std::string_view tz_name, std::chrono::year_month_day as_of_date) const -> const calendar&;
+
+		private:
+
+			auto _find_calendar(std::string_view tz_name) const -> std::size_t;
+
+			auto _get_name(const _calendar_db_calendar& c) const noexcept -> std::string_view;
+
+			struct _mapping;
+			struct _slot;
+
+			std::shared_ptr<const _mapping> _map; // shared with the calendars which refer to its pages
+			std::span<const _calendar_db_calendar> _calendars;
+			std::span<const _calendar_db_version> _versions;
+			std::span<const std::uint64_t> _pages;
+			std::size_t _page_size{ 0uz };
+			std::unique_ptr<_slot[]> _slots; // one per calendar
+
+		};
+
+
+		// locate_calendar (and so locate_joint_calendar) is served from the database in a given file from now on
+		// databases which have been used are kept mapped until the end of the process (calendars from them can still be in use)
+		void use_calendar_db(const std::filesystem::path& path);
+
+		// back to calendars made by the make* functions
+		void stop_using_calendar_db() noexcept;
+
+	}
+
+}
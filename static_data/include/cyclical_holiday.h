@@ -25,6 +25,7 @@
 #include <annual_holiday_interface.h>
 
 #include <chrono>
+#include <span>
 #include <utility>
 #include <algorithm>
 
@@ -53,6 +54,7 @@ namespace gregorian
 		private:
 
 			auto _make_holiday(const std::chrono::year& y) const noexcept -> std::chrono::year_month_day final;
+			void _make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept final;
 
 		private:
 
@@ -85,6 +87,18 @@ namespace gregorian
 
 			return d;
 		}
+
+		template<typename T>
+		void _cyclical_holiday<T>::_make_holidays(const std::chrono::year& from, std::span<std::chrono::year_month_day> output) const noexcept
+		{
+			const auto until = from + std::chrono::years{ static_cast<int>(output.size()) - 1 };
+			_holiday.make_holidays(util::years_period{ from, until }, output);
+
+			auto y = from;
+			for (auto& d : output)
+				if ((y++ - _start) % _period != std::chrono::years{ 0 })
+					d = d.year() / d.month() / std::chrono::day{ 32u }; // the same "magic" invalid date as in _make_holiday
+		}
 		// is it too convoluted to rely on a "magic" invalid date to indicate that there is no holiday in a given year?
 
 	}
@@ -110,9 +110,10 @@ namespace gregorian
 
 
 		// should it be in algorithms?
-		inline /*constexpr*/ auto adjust(
+		template<business_day_adjuster_type A> // so a built-in adjuster is dispatched statically
+		/*constexpr*/ auto adjust(
 			const schedule::dates& dates, // or take a copy and adjust in place?
-			const business_day_adjuster& adjuster,
+			const A& adjuster,
 			const calendar& calendar
 		) -> schedule::dates
 		{
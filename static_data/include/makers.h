@@ -25,8 +25,10 @@
 #include <calendar.h>
 
 #include <chrono>
-#include <map> // for _get_calendar_registry only
-#include <string_view> // for _get_calendar_registry only
+#include <map>
+#include <string_view>
+#include <vector>
+#include <cstddef>
 
 
 namespace gregorian
@@ -37,12 +39,39 @@ namespace gregorian
 
 		using _calendar_versions = std::map<std::chrono::year_month_day, calendar>;
 
+		// flat index of the versions of a calendar, which calendar_handle looks them up in
+		struct _calendar_index final
+		{
+			std::string_view tz_name;
+			std::vector<std::chrono::year_month_day> as_of_dates; // in order
+			std::vector<const calendar*> calendars; // in the same order
+		};
+
+		// the calendars stay where they are (so cal_versions has to outlive the index)
+		[[nodiscard]] auto _make_calendar_index(std::string_view tz_name, const _calendar_versions& cal_versions) -> _calendar_index;
+
+		// the latest version with holidays within the period of s replaced by the ones of s becomes the version as of as_of_date
+		// (which has to be after the latest one), see calendar::derive
+		// (versions only share the pages of non business days which the latest version has populated, so the first one should not be lazy)
+		void _add_calendar_version(_calendar_versions& cal_versions, const std::chrono::year_month_day& as_of_date, const schedule& s);
+
 		// below are exposed for testing purposes only
-		using _calendar_registry = std::map<std::string_view, _calendar_versions>;
-		// should it be string rather than string_view?
-		// is map a correct data structure for this?
 
-		auto _get_calendar_registry() -> const _calendar_registry&;
+		[[nodiscard]] auto _get_calendar_names() -> std::vector<std::string_view>; // in order
+
+		// made on first use (all versions of the calendar at once)
+		[[nodiscard]] auto _get_calendar_versions(std::string_view tz_name) -> const _calendar_versions&;
+
+		[[nodiscard]] auto _is_calendar_made(std::string_view tz_name) -> bool;
+
+		class calendar_db;
+
+		// database which locate_calendar is served from (if use_calendar_db has been called)
+		[[nodiscard]] auto _get_calendar_db() noexcept -> const calendar_db*;
+
+		constexpr auto _joint_calendars_capacity = 1024uz;
+
+		auto _get_joint_calendars_size() -> std::size_t;
 
 
 
@@ -28,6 +28,8 @@
 
 #include <chrono>
 #include <string_view>
+#include <span>
+#include <memory>
 
 
 namespace gregorian
@@ -43,6 +45,49 @@ namespace gregorian
 		// has tz_data "as of date" functionality?
 		// should we pass parametes by value or by const reference?
 
+		struct _calendar_index;
+
+		// a calendar resolved by its name, which callers can keep (e.g. rather than locate a calendar per trade),
+		// so only the version is looked up (a binary search over a contiguous array of as of dates)
+		// handles are made by locate_calendar_handle and are valid for as long as the calendars they were made from
+		class calendar_handle final
+		{
+
+		public:
+
+			explicit calendar_handle(const _calendar_index& index) noexcept;
+
+		public:
+
+			[[nodiscard]] auto get_name() const noexcept -> std::string_view;
+
+			// the same as locate_calendar (with the name of this handle)
+			[[nodiscard]] auto locate(std::chrono::year_month_day as_of_date) const -> const calendar&;
+
+			// as of dates of all the versions (in order)
+			[[nodiscard]] auto get_as_of_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+
+		private:
+
+			const _calendar_index* _index;
+
+		};
+
+		// throws std::runtime_error if there is no calendar with a given name
+		[[nodiscard]] auto locate_calendar_handle(std::string_view tz_name) -> calendar_handle;
+
+		// union of the calendars with given names (e.g. for settlement of a cross currency trade)
+		// joint calendars are cached by the calendar versions they are made of, so the order of names, repeated names
+		// and as of dates which locate the same versions do not matter and a repeated request does not rebuild anything
+		// the cache is bounded (the least recently used joint calendar goes first),
+		// hence shared_ptr rather than a reference - an evicted calendar lives for as long as it is used
+		[[nodiscard]] auto locate_joint_calendar(std::span<const std::string_view> tz_names, std::chrono::year_month_day as_of_date) -> std::shared_ptr<const calendar>;
+
+		// calendars are made (all of their versions) the first time they are located,
+		// prewarm makes the ones with given names (or all of them) in advance and in parallel, e.g. at start up
+		void prewarm(std::span<const std::string_view> tz_names);
+		void prewarm();
+
 
 		constexpr auto Epoch = util::period{
 			std::chrono::year{ 2012 } / FirstDayOfJanuary, // all calendars should include holidays from at least this day
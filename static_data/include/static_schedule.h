@@ -0,0 +1,154 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <period.h>
+#include <schedule.h>
+#include <weekend.h>
+#include <calendar.h>
+#include <annual_holiday_interface.h>
+
+#include <chrono>
+#include <array>
+#include <span>
+#include <vector>
+#include <bit>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		// experimental: nothing in the registry is made this way yet (all calendars are still made from their rules at run time),
+		// this is only a building block for serving calendars from read-only data
+
+		// holidays of a schedule as a bitmap of its days (bit i of words[i / 64] is the i-th day of the period)
+		// and non business days of a calendar with these holidays and a given weekend (the same way)
+		// made at compile time, so that a calendar can be made from read-only data without applying any rules at run time
+		template<std::size_t Days>
+		struct _static_schedule final
+		{
+			util::days_period period;
+			weekend we;
+			std::array<std::uint64_t, (Days + 63uz) / 64uz> words;
+			std::array<std::uint64_t, (Days + 63uz) / 64uz> non_business_days;
+		};
+
+
+		// number of days in [from, until]
+		[[nodiscard]] constexpr auto _count_days(const util::days_period& p) noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>((std::chrono::sys_days{ p.get_until() } - std::chrono::sys_days{ p.get_from() }).count()) + 1uz;
+		}
+
+		// known holidays (outside of the period they are ignored) and holidays of the rules for the generated years
+		// (like known_schedule + make_holiday_schedule(generated, rules), but at compile time)
+		template<std::size_t Days>
+		[[nodiscard]] consteval auto _make_static_schedule(
+			const util::days_period& p,
+			const weekend& we,
+			std::span<const std::chrono::year_month_day> known_holidays,
+			std::span<const annual_holiday* const> rules,
+			const util::years_period& generated
+		) -> _static_schedule<Days>
+		{
+			if (_count_days(p) != Days)
+				throw std::invalid_argument{ "Number of days should be the same as in the period" };
+
+			auto s = _static_schedule<Days>{ p, we, {}, {} };
+
+			const auto add = [&s](const std::chrono::year_month_day& d)
+			{
+				if (d.ok() && s.period.contains(d)) // skip rules that don't produce a holiday for this year
+				{
+					const auto i = static_cast<std::size_t>((std::chrono::sys_days{ d } - std::chrono::sys_days{ s.period.get_from() }).count());
+					s.words[i / 64uz] |= std::uint64_t{ 1u } << (i % 64uz);
+				}
+			};
+
+			for (const auto& d : known_holidays)
+				add(d);
+
+			for (auto y = generated.get_from(); y <= generated.get_until(); ++y)
+				for (const auto* rule : rules)
+					add(rule->make_holiday(y));
+
+			// bits past the end of the period stay clear
+			const auto from = std::chrono::sys_days{ p.get_from() };
+			for (auto i = 0uz; i < Days; ++i)
+				if (we.is_weekend(from + std::chrono::days{ i }))
+					s.non_business_days[i / 64uz] |= std::uint64_t{ 1u } << (i % 64uz);
+
+			for (auto w = 0uz; w < s.words.size(); ++w)
+				s.non_business_days[w] |= s.words[w];
+
+			return s;
+		}
+
+		template<std::size_t Days>
+		[[nodiscard]] consteval auto _make_static_schedule(
+			const util::days_period& p,
+			const weekend& we,
+			std::span<const annual_holiday* const> rules
+		) -> _static_schedule<Days>
+		{
+			return _make_static_schedule<Days>(
+				p,
+				we,
+				{},
+				rules,
+				util::years_period{ p.get_from().year(), p.get_until().year() }
+			);
+		}
+
+
+		// dates are read off the bitmap in order (no rules are applied)
+		template<std::size_t Days>
+		[[nodiscard]] auto _make_schedule(const _static_schedule<Days>& s) -> schedule
+		{
+			const auto from = std::chrono::sys_days{ s.period.get_from() };
+
+			auto hols = std::vector<std::chrono::year_month_day>{};
+			for (auto w = 0uz; w < s.words.size(); ++w)
+				for (auto word = s.words[w]; word != 0u; word &= word - 1u)
+					hols.push_back(from + std::chrono::days{ static_cast<int>(w * 64uz) + std::countr_zero(word) });
+
+			return make_schedule(s.period, std::move(hols));
+		}
+
+		// non business days are served straight from the table (nothing is generated or copied, so s has to be static),
+		// only the holidays are read into a schedule
+		template<std::size_t Days>
+		[[nodiscard]] auto _make_calendar(const _static_schedule<Days>& s) -> calendar
+		{
+			return calendar{ s.we, _make_schedule(s), s.non_business_days, nullptr };
+		}
+
+	}
+
+}
@@ -609,99 +609,29 @@ namespace gregorian
 
 		auto make_England_calendar_versions() -> _calendar_versions
 		{
+			// each version is the one before it with the known part published since replacing the generated one
+			// (or replacing an earlier known part, e.g. 2b replaces 2a), so only a few pages of each are written
 			auto cal0 = calendar{
 				SaturdaySundayWeekend,
 				_make_England_known_schedule_part0() +
 				_make_England_generated_schedule(years_period{ 1999y, Epoch.get_until().year() })
 			};
 
-			auto cal1 = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_generated_schedule(years_period{ 2002y, Epoch.get_until().year() })
-			};
-
-			auto cal2a = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2a() +
-				_make_England_generated_schedule(years_period{ 2012y, Epoch.get_until().year() })
-			};
-
-			auto cal2b = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_generated_schedule(years_period{ 2012y, Epoch.get_until().year() })
-			};
-
-			auto cal3 = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_known_schedule_part3() +
-				_make_England_generated_schedule(years_period{ 2020y, Epoch.get_until().year() })
-			};
-
-			auto cal4 = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_known_schedule_part3() +
-				_make_England_known_schedule_part4() +
-				_make_England_generated_schedule(years_period{ 2022y, Epoch.get_until().year() })
-			};
+			const auto from = cal0.get_schedule().get_period().get_from();
 
-			auto cal5a = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_known_schedule_part3() +
-				_make_England_known_schedule_part4() +
-				_make_England_known_schedule_part5a() +
-				_make_England_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
+			auto cal_versions = _calendar_versions{};
+			cal_versions.emplace(from, std::move(cal0));
 
-			auto cal5b = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_known_schedule_part3() +
-				_make_England_known_schedule_part4() +
-				_make_England_known_schedule_part5b() +
-				_make_England_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
+			_add_calendar_version(cal_versions, 1998y / June / 3d, _make_England_known_schedule_part1());
+			_add_calendar_version(cal_versions, 2000y / November / 23d, _make_England_known_schedule_part2a());
+			_add_calendar_version(cal_versions, 2010y / January / 5d, _make_England_known_schedule_part2b());
+			_add_calendar_version(cal_versions, 2010y / November / 23d, _make_England_known_schedule_part3());
+			_add_calendar_version(cal_versions, 2019y / June / 7d, _make_England_known_schedule_part4());
+			_add_calendar_version(cal_versions, 2020y / November / 12d, _make_England_known_schedule_part5a());
+			_add_calendar_version(cal_versions, 2022y / September / 10d, _make_England_known_schedule_part5b());
+			_add_calendar_version(cal_versions, 2022y / November / 6d, _make_England_known_schedule_part6());
 
-			auto cal6 = calendar{
-				SaturdaySundayWeekend,
-				_make_England_known_schedule_part0() +
-				_make_England_known_schedule_part1() +
-				_make_England_known_schedule_part2b() +
-				_make_England_known_schedule_part3() +
-				_make_England_known_schedule_part4() +
-				_make_England_known_schedule_part5b() +
-				_make_England_known_schedule_part6() +
-				_make_England_generated_schedule(years_period{ 2029y, Epoch.get_until().year() })
-			};
-
-			return {
-				{ cal0.get_schedule().get_period().get_from(), std::move(cal0) },
-				{ 1998y / June / 3d, std::move(cal1) },
-				{ 2000y / November / 23d, std::move(cal2a) },
-				{ 2010y / January / 5d, std::move(cal2b) },
-				{ 2010y / November / 23d, std::move(cal3) },
-				{ 2019y / June / 7d, std::move(cal4) },
-				{ 2020y / November / 12d, std::move(cal5a) },
-				{ 2022y / September / 10d, std::move(cal5b) },
-				{ 2022y / November / 6d, std::move(cal6) },
-			};
+			return cal_versions;
 		}
 
 
@@ -1068,58 +998,21 @@ namespace gregorian
 				_make_Scotland_generated_schedule(years_period{ 2020y, Epoch.get_until().year() })
 			};
 
-			auto cal1 = calendar{
-				SaturdaySundayWeekend,
-				_make_Scotland_known_schedule_part0() +
-				_make_Scotland_known_schedule_part1() +
-				_make_Scotland_generated_schedule(years_period{ 2022y, Epoch.get_until().year() })
-			};
-
-			auto cal2 = calendar{
-				SaturdaySundayWeekend,
-				_make_Scotland_known_schedule_part0() +
-				_make_Scotland_known_schedule_part1() +
-				_make_Scotland_known_schedule_part2a() +
-				_make_Scotland_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
+			const auto from = cal0.get_schedule().get_period().get_from();
 
-			auto cal3 = calendar{
-				SaturdaySundayWeekend,
-				_make_Scotland_known_schedule_part0() +
-				_make_Scotland_known_schedule_part1() +
-				_make_Scotland_known_schedule_part2b() +
-				_make_Scotland_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
+			auto cal_versions = _calendar_versions{};
+			cal_versions.emplace(from, std::move(cal0));
 
-			auto cal4 = calendar{
-				SaturdaySundayWeekend,
-				_make_Scotland_known_schedule_part0() +
-				_make_Scotland_known_schedule_part1() +
-				_make_Scotland_known_schedule_part2b() +
-				_make_Scotland_known_schedule_part3a() +
-				_make_Scotland_generated_schedule(years_period{ 2029y, Epoch.get_until().year() })
-			};
-
-			auto cal5 = calendar{
-				SaturdaySundayWeekend,
-				_make_Scotland_known_schedule_part0() +
-				_make_Scotland_known_schedule_part1() +
-				_make_Scotland_known_schedule_part2b() +
-				_make_Scotland_known_schedule_part3b() +
-				_make_Scotland_generated_schedule(years_period{ 2029y, Epoch.get_until().year() })
-			};
+			_add_calendar_version(cal_versions, 2019y / June / 7d, _make_Scotland_known_schedule_part1());
+			_add_calendar_version(cal_versions, 2020y / November / 12d, _make_Scotland_known_schedule_part2a());
+			_add_calendar_version(cal_versions, 2022y / September / 10d, _make_Scotland_known_schedule_part2b());
+			_add_calendar_version(cal_versions, 2022y / November / 6d, _make_Scotland_known_schedule_part3a());
+			_add_calendar_version(cal_versions, 2026y / February / 5d, _make_Scotland_known_schedule_part3b()); // https://www.gov.scot/news/world-cup-bank-holiday-confirmed/
 
 			// or should we consider having known part for each year? (more functions, but maybe more clear?)
 			// (and generated schedule for each small "epoch")
 
-			return {
-				{ cal0.get_schedule().get_period().get_from(), std::move(cal0) },
-				{ 2019y / June / 7d, std::move(cal1) },
-				{ 2020y / November / 12d, std::move(cal2) },
-				{ 2022y / September / 10d, std::move(cal3) },
-				{ 2022y / November / 6d, std::move(cal4) },
-				{ 2026y / February / 5d, std::move(cal5) }, // https://www.gov.scot/news/world-cup-bank-holiday-confirmed/
-			};
+			return cal_versions;
 		}
 
 
@@ -1423,45 +1316,17 @@ namespace gregorian
 				_make_Northern_Ireland_generated_schedule(years_period{ 2020y, Epoch.get_until().year() })
 			};
 
-			auto cal1 = calendar{
-				SaturdaySundayWeekend,
-				_make_Northern_Ireland_known_schedule_part0() +
-				_make_Northern_Ireland_known_schedule_part1() +
-				_make_Northern_Ireland_generated_schedule(years_period{ 2022y, Epoch.get_until().year() })
-			};
+			const auto from = cal0.get_schedule().get_period().get_from();
 
-			auto cal2 = calendar{
-				SaturdaySundayWeekend,
-				_make_Northern_Ireland_known_schedule_part0() +
-				_make_Northern_Ireland_known_schedule_part1() +
-				_make_Northern_Ireland_known_schedule_part2a() +
-				_make_Northern_Ireland_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
+			auto cal_versions = _calendar_versions{};
+			cal_versions.emplace(from, std::move(cal0));
 
-			auto cal3 = calendar{
-				SaturdaySundayWeekend,
-				_make_Northern_Ireland_known_schedule_part0() +
-				_make_Northern_Ireland_known_schedule_part1() +
-				_make_Northern_Ireland_known_schedule_part2b() +
-				_make_Northern_Ireland_generated_schedule(years_period{ 2023y, Epoch.get_until().year() })
-			};
-
-			auto cal4 = calendar{
-				SaturdaySundayWeekend,
-				_make_Northern_Ireland_known_schedule_part0() +
-				_make_Northern_Ireland_known_schedule_part1() +
-				_make_Northern_Ireland_known_schedule_part2b() +
-				_make_Northern_Ireland_known_schedule_part3() +
-				_make_Northern_Ireland_generated_schedule(years_period{ 2029y, Epoch.get_until().year() })
-			};
+			_add_calendar_version(cal_versions, 2019y / June / 7d, _make_Northern_Ireland_known_schedule_part1());
+			_add_calendar_version(cal_versions, 2020y / November / 12d, _make_Northern_Ireland_known_schedule_part2a());
+			_add_calendar_version(cal_versions, 2022y / September / 10d, _make_Northern_Ireland_known_schedule_part2b());
+			_add_calendar_version(cal_versions, 2022y / November / 6d, _make_Northern_Ireland_known_schedule_part3());
 
-			return {
-				{ cal0.get_schedule().get_period().get_from(), std::move(cal0) },
-				{ 2019y / June / 7d, std::move(cal1) },
-				{ 2020y / November / 12d, std::move(cal2) },
-				{ 2022y / September / 10d, std::move(cal3) },
-				{ 2022y / November / 6d, std::move(cal4) },
-			};
+			return cal_versions;
 		}
 
 
@@ -2052,17 +2052,19 @@ namespace gregorian
 					Federal::_make_generated_schedule_part0()
 				};
 
-				auto cal1 = calendar{
-					SaturdaySundayWeekend,
-					Federal::_make_known_schedule_part0() +
+				const auto from = cal0.get_schedule().get_period().get_from();
+
+				auto cal_versions = _calendar_versions{};
+				cal_versions.emplace(from, std::move(cal0));
+
+				_add_calendar_version(
+					cal_versions,
+					2021y / June / 17d,
 					Federal::_make_known_schedule_part1() +
 					Federal::_make_generated_schedule_part1()
-				};
+				); // President Joe Biden signed the bill (Pub. L. 11717) on June 17, 2021, making Juneteenth the eleventh American federal holiday
 
-				return {
-					{ cal0.get_schedule().get_period().get_from(), std::move(cal0) },
-					{ 2021y / June / 17d, std::move(cal1) }, // President Joe Biden signed the bill (Pub. L. 11717) on June 17, 2021, making Juneteenth the eleventh American federal holiday
-				};
+				return cal_versions;
 			}
 
 
@@ -2074,17 +2076,19 @@ namespace gregorian
 					Washington_DC_Federal::_make_generated_schedule_part0()
 				};
 
-				auto cal1 = calendar{
-					SaturdaySundayWeekend,
-					Washington_DC_Federal::_make_known_schedule_part0() +
+				const auto from = cal0.get_schedule().get_period().get_from();
+
+				auto cal_versions = _calendar_versions{};
+				cal_versions.emplace(from, std::move(cal0));
+
+				_add_calendar_version(
+					cal_versions,
+					2021y / June / 17d,
 					Washington_DC_Federal::_make_known_schedule_part1() +
 					Washington_DC_Federal::_make_generated_schedule_part1()
-				};
+				); // President Joe Biden signed the bill (Pub. L. 11717) on June 17, 2021, making Juneteenth the eleventh American federal holiday
 
-				return {
-					{ cal0.get_schedule().get_period().get_from(), std::move(cal0) },
-					{ 2021y / June / 17d, std::move(cal1) }, // President Joe Biden signed the bill (Pub. L. 11717) on June 17, 2021, making Juneteenth the eleventh American federal holiday
-				};
+				return cal_versions;
 			}
 
 
@@ -0,0 +1,203 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bitemporal_calendar.h"
+#include "static_data.h"
+
+#include <calendar.h>
+#include <period.h>
+#include <time_series.h>
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		bitemporal_calendar::bitemporal_calendar(calendar_handle h) :
+			_handle{ h }
+		{
+			const auto as_of_dates = _handle.get_as_of_dates();
+			assert(!as_of_dates.empty());
+
+			_as_of_dates.assign(as_of_dates.begin(), as_of_dates.end());
+			_calendars.reserve(_as_of_dates.size());
+			_periods.reserve(_as_of_dates.size());
+			for (const auto& as_of_date : _as_of_dates)
+			{
+				const auto& cal = _handle.locate(as_of_date);
+				const auto& p = cal.get_schedule().get_period();
+				_calendars.push_back(&cal);
+				_periods.emplace_back(sys_days{ p.get_from() }, sys_days{ p.get_until() });
+			}
+
+			auto from = _periods.front().get_from();
+			auto until = _periods.front().get_until();
+			for (const auto& p : _periods)
+			{
+				from = max(from, p.get_from());
+				until = min(until, p.get_until());
+			}
+			if (until < from)
+				return; // everything goes to the versions
+
+			_common.emplace(from, until);
+
+			// a day which is not the same in all the versions differs between some consecutive ones
+			for (auto v = 1uz; v < _calendars.size(); ++v)
+			{
+				auto ds = vector<sys_days>{};
+				for (const auto& d : _calendars[v - 1uz]->find_differences(*_calendars[v]))
+					if (_common->contains(d))
+						ds.push_back(d);
+
+				auto merged = vector<sys_days>{};
+				merged.reserve(_changed_days.size() + ds.size());
+				ranges::set_union(_changed_days, ds, back_inserter(merged));
+				_changed_days = std::move(merged);
+			}
+
+			_changed.emplace(util::days_period{ from, until });
+			for (const auto& d : _changed_days)
+				(*_changed)[d] = true;
+
+			_words_per_day = (_calendars.size() + 63uz) / 64uz;
+			_business_days.assign(_changed_days.size() * _words_per_day, 0u);
+			for (auto i = 0uz; i < _changed_days.size(); ++i)
+				for (auto v = 0uz; v < _calendars.size(); ++v)
+					if (_calendars[v]->is_business_day_unchecked(_changed_days[i]))
+						_business_days[i * _words_per_day + v / 64uz] |= uint64_t{ 1u } << (v % 64uz);
+		}
+
+
+		auto bitemporal_calendar::get_name() const noexcept -> string_view
+		{
+			return _handle.get_name();
+		}
+
+		auto bitemporal_calendar::get_changed_days() const noexcept -> span<const sys_days>
+		{
+			return _changed_days;
+		}
+
+
+		auto bitemporal_calendar::is_business_day(const sys_days& sd, const year_month_day& as_of_date) const -> bool
+		{
+			const auto v = _locate(as_of_date);
+			if (!_periods[v].contains(sd))
+				throw out_of_range{ "Request is not consistent with from/until" };
+
+			return _is_business_day(sd, v);
+		}
+
+		auto bitemporal_calendar::count_business_days(const util::period<sys_days>& p, const year_month_day& as_of_date) const -> size_t
+		{
+			const auto v = _locate(as_of_date);
+			if (!_periods[v].contains(p))
+				throw out_of_range{ "Request is not consistent with from/until" };
+
+			return _count_business_days(p, v);
+		}
+
+
+		void bitemporal_calendar::is_business_day(span<const sys_days> sds, span<const year_month_day> as_of_dates, span<bool> out) const
+		{
+			is_business_day(execution::seq, sds, as_of_dates, out);
+		}
+
+		void bitemporal_calendar::count_business_days(span<const util::period<sys_days>> ps, span<const year_month_day> as_of_dates, span<size_t> out) const
+		{
+			count_business_days(execution::seq, ps, as_of_dates, out);
+		}
+
+
+		auto bitemporal_calendar::_locate(const year_month_day& as_of_date) const -> size_t
+		{
+			const auto v = _find(as_of_date);
+			if (v == _calendars.size())
+				throw runtime_error{ "calendar's version as of date "s + string{ _handle.get_name() } + " could not be located"s };
+
+			return v;
+		}
+
+		auto bitemporal_calendar::_find(const year_month_day& as_of_date) const noexcept -> size_t
+		{
+			const auto it = ranges::upper_bound(_as_of_dates, as_of_date);
+			return it != _as_of_dates.cbegin() ? static_cast<size_t>(it - _as_of_dates.cbegin()) - 1uz : _calendars.size();
+		}
+
+		auto bitemporal_calendar::_is_business_day(const sys_days& sd, const size_t version) const noexcept -> bool
+		{
+			if (!_common || !_common->contains(sd))
+				return _calendars[version]->is_business_day_unchecked(sd);
+
+			// most days are the same in all the versions
+			if (!_changed->get_unchecked(sd))
+				return _calendars.back()->is_business_day_unchecked(sd);
+
+			const auto i = static_cast<size_t>(ranges::lower_bound(_changed_days, sd) - _changed_days.cbegin());
+			return _is_changed_business_day(i, version);
+		}
+
+		auto bitemporal_calendar::_count_business_days(const util::period<sys_days>& p, const size_t version) const noexcept -> size_t
+		{
+			if (!_common || !_common->contains(p))
+				return _calendars[version]->count_business_days(p);
+
+			// the latest version corrected by the changed days within p
+			auto count = _calendars.back()->count_business_days(p);
+
+			const auto latest = _calendars.size() - 1uz;
+			const auto first = ranges::lower_bound(_changed_days, p.get_from());
+			const auto last = ranges::upper_bound(_changed_days, p.get_until());
+			for (auto it = first; it != last; ++it)
+			{
+				const auto i = static_cast<size_t>(it - _changed_days.cbegin());
+				const auto is_business_day = _is_changed_business_day(i, version);
+				if (is_business_day != _is_changed_business_day(i, latest))
+					is_business_day ? ++count : --count;
+			}
+
+			return count;
+		}
+
+		auto bitemporal_calendar::_is_changed_business_day(const size_t i, const size_t version) const noexcept -> bool
+		{
+			return (_business_days[i * _words_per_day + version / 64uz] & (uint64_t{ 1u } << (version % 64uz))) != 0u;
+		}
+
+	}
+
+}
@@ -0,0 +1,532 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "calendar_db.h"
+#include "makers.h"
+#include "static_data.h"
+
+#include <calendar.h>
+#include <schedule.h>
+#include <weekend.h>
+#include <period.h>
+#include <time_series.h>
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <filesystem>
+#include <fstream>
+#include <bit>
+#include <bitset>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	using namespace util;
+
+	namespace static_data
+	{
+
+		static_assert(is_trivially_copyable_v<_calendar_db_header> && sizeof(_calendar_db_header) == 56uz);
+		static_assert(is_trivially_copyable_v<_calendar_db_calendar> && sizeof(_calendar_db_calendar) == 16uz);
+		static_assert(is_trivially_copyable_v<_calendar_db_version> && sizeof(_calendar_db_version) == 48uz);
+
+		static constexpr char _calendar_db_magic[8] = { 'g', 'r', 'e', 'g', 'c', 'a', 'l', '\0' };
+
+
+		static auto _to_serial(const sys_days& sd) -> int32_t
+		{
+			return static_cast<int32_t>(sd.time_since_epoch().count());
+		}
+
+		static auto _from_serial(const int32_t serial) -> sys_days
+		{
+			return sys_days{ days{ serial } };
+		}
+
+		static auto _word_count(const int32_t from, const int32_t until) -> uint64_t
+		{
+			return (static_cast<uint64_t>(static_cast<int64_t>(until) - from) + 1u + 63u) / 64u;
+		}
+
+		static auto _page_count(const uint64_t word_count, const uint64_t page_size) -> uint64_t
+		{
+			return (word_count + page_size - 1u) / page_size;
+		}
+
+		static auto _align(const size_t offset, const size_t alignment) -> size_t
+		{
+			return (offset + alignment - 1uz) / alignment * alignment;
+		}
+
+		template<typename T>
+		static void _copy_to(vector<byte>& bytes, const size_t offset, span<const T> ts)
+		{
+			if (!ts.empty())
+				memcpy(bytes.data() + offset, ts.data(), ts.size_bytes());
+		}
+
+
+		void write_calendar_db(const filesystem::path& path)
+		{
+			if constexpr (endian::native != endian::little)
+				throw runtime_error{ "calendar database is only supported on little endian platforms" };
+
+			auto calendars = vector<_calendar_db_calendar>{};
+			auto versions = vector<_calendar_db_version>{};
+			auto names = string{};
+			auto holidays = vector<int32_t>{};
+			auto page_refs = vector<uint32_t>{};
+
+			// each page is written once (versions of a calendar usually differ by a page or two)
+			const auto page_size = time_series<bool>::get_page_words();
+			auto pages = vector<uint64_t>{};
+			auto page_indices = map<vector<uint64_t>, uint32_t>{};
+
+			// offsets are indices to begin with, the sections are placed once their sizes are known
+			for (const auto tz_name : _get_calendar_names())
+			{
+				const auto& cal_versions = _get_calendar_versions(tz_name);
+
+				calendars.push_back(_calendar_db_calendar{
+					.name_offset = static_cast<uint32_t>(names.size()),
+					.name_size = static_cast<uint32_t>(tz_name.size()),
+					.first_version = static_cast<uint32_t>(versions.size()),
+					.version_count = static_cast<uint32_t>(cal_versions.size())
+				});
+				names += tz_name;
+
+				for (const auto& [as_of_date, cal] : cal_versions)
+				{
+					const auto [f, u] = cal.get_schedule().get_period().from_until();
+					const auto from = _to_serial(sys_days{ f });
+					const auto until = _to_serial(sys_days{ u });
+
+					auto we = uint32_t{ 0u };
+					for (auto wd = 0u; wd < 7u; ++wd)
+						if (cal.get_weekend().get_we()[wd])
+							we |= 1u << wd;
+
+					const auto first_holiday = holidays.size();
+					for (const auto& holiday : cal.get_schedule().get_dates())
+						holidays.push_back(_to_serial(sys_days{ holiday }));
+
+					auto words = vector<uint64_t>(_page_count(_word_count(from, until), page_size) * page_size);
+					for (auto d = from; d <= until; ++d)
+						if (cal.is_non_business_day(_from_serial(d)))
+							words[static_cast<size_t>(d - from) / 64uz] |= uint64_t{ 1u } << (static_cast<size_t>(d - from) % 64uz);
+
+					const auto first_page_ref = page_refs.size();
+					for (auto first = words.cbegin(); first != words.cend(); first += static_cast<ptrdiff_t>(page_size))
+					{
+						auto page = vector<uint64_t>{ first, first + static_cast<ptrdiff_t>(page_size) };
+						const auto [it, added] = page_indices.try_emplace(std::move(page), static_cast<uint32_t>(pages.size() / page_size));
+						if (added)
+							pages.insert(pages.end(), first, first + static_cast<ptrdiff_t>(page_size));
+
+						page_refs.push_back(it->second);
+					}
+
+					versions.push_back(_calendar_db_version{
+						.as_of_date = _to_serial(sys_days{ as_of_date }),
+						.from = from,
+						.until = until,
+						.weekend = we,
+						.holidays_offset = first_holiday,
+						.holiday_count = holidays.size() - first_holiday,
+						.page_refs_offset = first_page_ref,
+						.page_ref_count = page_refs.size() - first_page_ref
+					});
+				}
+			}
+
+			const auto calendars_offset = sizeof(_calendar_db_header);
+			const auto versions_offset = calendars_offset + calendars.size() * sizeof(_calendar_db_calendar);
+			const auto names_offset = versions_offset + versions.size() * sizeof(_calendar_db_version);
+			const auto holidays_offset = _align(names_offset + names.size(), alignof(int32_t));
+			const auto page_refs_offset = _align(holidays_offset + holidays.size() * sizeof(int32_t), alignof(uint32_t));
+			const auto pages_offset = _align(page_refs_offset + page_refs.size() * sizeof(uint32_t), page_size * sizeof(uint64_t));
+			const auto file_size = pages_offset + pages.size() * sizeof(uint64_t);
+
+			for (auto& c : calendars)
+				c.name_offset += static_cast<uint32_t>(names_offset);
+
+			for (auto& v : versions)
+			{
+				v.holidays_offset = holidays_offset + v.holidays_offset * sizeof(int32_t);
+				v.page_refs_offset = page_refs_offset + v.page_refs_offset * sizeof(uint32_t);
+			}
+
+			auto header = _calendar_db_header{
+				.magic = {},
+				.format_version = _calendar_db_format_version,
+				.calendar_count = static_cast<uint32_t>(calendars.size()),
+				.version_count = versions.size(),
+				.pages_offset = pages_offset,
+				.page_count = pages.size() / page_size,
+				.page_size = page_size,
+				.file_size = file_size
+			};
+			ranges::copy(_calendar_db_magic, header.magic);
+
+			auto bytes = vector<byte>(file_size);
+			_copy_to(bytes, 0uz, span<const _calendar_db_header>{ &header, 1uz });
+			_copy_to(bytes, calendars_offset, span<const _calendar_db_calendar>{ calendars });
+			_copy_to(bytes, versions_offset, span<const _calendar_db_version>{ versions });
+			_copy_to(bytes, names_offset, span<const char>{ names });
+			_copy_to(bytes, holidays_offset, span<const int32_t>{ holidays });
+			_copy_to(bytes, page_refs_offset, span<const uint32_t>{ page_refs });
+			_copy_to(bytes, pages_offset, span<const uint64_t>{ pages });
+
+			auto tmp_path = path;
+			tmp_path += ".tmp";
+
+			{
+				auto out = ofstream{ tmp_path, ios::binary | ios::trunc };
+				out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+				out.close();
+				if (!out)
+					throw runtime_error{ "calendar database "s + tmp_path.string() + " could not be written"s };
+			}
+
+			filesystem::rename(tmp_path, path);
+		}
+
+
+
+		struct calendar_db::_mapping final
+		{
+			explicit _mapping(const filesystem::path& path)
+			{
+#ifdef _WIN32
+				file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE)
+					throw runtime_error{ "calendar database "s + path.string() + " could not be opened"s };
+
+				auto file_size = LARGE_INTEGER{};
+				if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+				{
+					CloseHandle(file);
+					throw runtime_error{ "calendar database "s + path.string() + " could not be mapped"s };
+				}
+
+				mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				const auto* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+				if (!view)
+				{
+					if (mapping)
+						CloseHandle(mapping);
+					CloseHandle(file);
+					throw runtime_error{ "calendar database "s + path.string() + " could not be mapped"s };
+				}
+
+				data = static_cast<const byte*>(view);
+				size = static_cast<size_t>(file_size.QuadPart);
+#else
+				const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+				if (fd == -1)
+					throw runtime_error{ "calendar database "s + path.string() + " could not be opened"s };
+
+				struct stat st{};
+				const auto* view = ::fstat(fd, &st) == 0 && st.st_size > 0 ?
+					::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0) :
+					MAP_FAILED;
+				::close(fd); // the mapping keeps the file alive
+
+				if (view == MAP_FAILED)
+					throw runtime_error{ "calendar database "s + path.string() + " could not be mapped"s };
+
+				data = static_cast<const byte*>(view);
+				size = static_cast<size_t>(st.st_size);
+#endif
+			}
+
+			_mapping(const _mapping&) = delete;
+			auto operator=(const _mapping&) -> _mapping& = delete;
+
+			~_mapping() noexcept
+			{
+#ifdef _WIN32
+				UnmapViewOfFile(data);
+				CloseHandle(mapping);
+				CloseHandle(file);
+#else
+				::munmap(const_cast<byte*>(data), size);
+#endif
+			}
+
+			// sections are aligned to their element size within the file and the mapping is page aligned
+			template<typename T>
+			auto get(const uint64_t offset, const uint64_t count) const -> span<const T>
+			{
+				if (offset % alignof(T) != 0u || offset > size || count > (size - offset) / sizeof(T))
+					throw runtime_error{ "calendar database is not valid"s };
+
+				return span{ reinterpret_cast<const T*>(data + offset), static_cast<size_t>(count) };
+			}
+
+#ifdef _WIN32
+			HANDLE file{ INVALID_HANDLE_VALUE };
+			HANDLE mapping{ nullptr };
+#endif
+			const byte* data{ nullptr };
+			size_t size{ 0uz };
+		};
+
+		struct calendar_db::_slot final
+		{
+			once_flag made;
+			optional<_calendar_versions> versions;
+			optional<_calendar_index> index; // of the above
+		};
+
+
+		calendar_db::calendar_db(const filesystem::path& path) :
+			_map{ make_shared<const _mapping>(path) }
+		{
+			if constexpr (endian::native != endian::little)
+				throw runtime_error{ "calendar database is only supported on little endian platforms" };
+
+			const auto invalid = runtime_error{ "calendar database "s + path.string() + " is not valid"s };
+
+			try
+			{
+				const auto& header = _map->get<_calendar_db_header>(0u, 1u).front();
+				if (
+					!ranges::equal(header.magic, _calendar_db_magic) ||
+					header.format_version != _calendar_db_format_version ||
+					header.file_size != _map->size
+				)
+					throw invalid;
+
+				_calendars = _map->get<_calendar_db_calendar>(sizeof(_calendar_db_header), header.calendar_count);
+				_versions = _map->get<_calendar_db_version>(sizeof(_calendar_db_header) + _calendars.size_bytes(), header.version_count);
+
+				// calendars refer to whole pages, so they have to be of the same size as the ones of time series
+				if (header.page_size != time_series<bool>::get_page_words() || header.page_count > _map->size / sizeof(uint64_t) / header.page_size)
+					throw invalid;
+				_page_size = static_cast<size_t>(header.page_size);
+				_pages = _map->get<uint64_t>(header.pages_offset, header.page_count * header.page_size);
+
+				// everything is checked here, so that nothing needs to be checked when calendars are read
+				auto previous_name = optional<string_view>{};
+				for (const auto& c : _calendars)
+				{
+					const auto name = _map->get<char>(c.name_offset, c.name_size);
+					const auto tz_name = string_view{ name.data(), name.size() };
+					if (previous_name && *previous_name >= tz_name)
+						throw invalid;
+					previous_name = tz_name;
+
+					if (c.version_count == 0u || c.first_version > _versions.size() || c.version_count > _versions.size() - c.first_version)
+						throw invalid;
+
+					const auto vs = _versions.subspan(c.first_version, c.version_count);
+					if (!ranges::is_sorted(vs, ranges::less_equal{}, &_calendar_db_version::as_of_date))
+						throw invalid;
+				}
+
+				for (const auto& v : _versions)
+				{
+					if (v.from > v.until || v.weekend >= (1u << 7u))
+						throw invalid;
+
+					const auto word_count = _word_count(v.from, v.until);
+					if (v.page_ref_count != _page_count(word_count, _page_size))
+						throw invalid;
+
+					// schedules refer to the holidays as they are
+					const auto holidays = _map->get<int32_t>(v.holidays_offset, v.holiday_count);
+					if (!ranges::is_sorted(holidays, ranges::less_equal{}))
+						throw invalid;
+
+					const auto page_refs = _map->get<uint32_t>(v.page_refs_offset, v.page_ref_count);
+					if (ranges::any_of(page_refs, [this](const uint32_t ref) { return ref >= _pages.size() / _page_size; }))
+						throw invalid;
+
+					// and calendars to the pages, so bits past the end of the period have to be clear
+					const auto last_page = _pages.subspan(page_refs.back() * _page_size, _page_size);
+					const auto last_word = static_cast<size_t>((word_count - 1u) % _page_size);
+					const auto tail = (static_cast<uint64_t>(static_cast<int64_t>(v.until) - v.from) + 1u) % 64u;
+					if (
+						(tail != 0u && (last_page[last_word] >> tail) != uint64_t{ 0u }) ||
+						ranges::any_of(last_page.subspan(last_word + 1uz), [](const uint64_t word) { return word != uint64_t{ 0u }; })
+					)
+						throw invalid;
+				}
+			}
+			catch (const runtime_error&)
+			{
+				throw invalid;
+			}
+
+			_slots = make_unique<_slot[]>(_calendars.size());
+		}
+
+		calendar_db::~calendar_db() noexcept = default;
+
+
+		auto calendar_db::get_calendar_names() const -> vector<string_view>
+		{
+			auto names = vector<string_view>{};
+			names.reserve(_calendars.size());
+			for (const auto& c : _calendars)
+				names.push_back(_get_name(c));
+
+			return names;
+		}
+
+		auto calendar_db::locate_calendar_handle(string_view tz_name) const -> calendar_handle
+		{
+			const auto i = _find_calendar(tz_name);
+			auto& slot = _slots[i];
+
+			call_once(
+				slot.made,
+				[this, &slot, i]()
+				{
+					const auto& c = _calendars[i];
+
+					// holidays and non business days stay in the mapped pages (the calendars keep the mapping alive)
+					// and versions share the pages they refer to (versions usually differ by a page or two)
+					auto cal_versions = _calendar_versions{};
+					auto pages = vector<const uint64_t*>{};
+					for (const auto& v : _versions.subspan(c.first_version, c.version_count))
+					{
+						pages.clear();
+						for (const auto ref : _map->get<uint32_t>(v.page_refs_offset, v.page_ref_count))
+							pages.push_back(_pages.data() + ref * _page_size);
+
+						const auto period = days_period{ year_month_day{ _from_serial(v.from) }, year_month_day{ _from_serial(v.until) } };
+
+						cal_versions.emplace(
+							year_month_day{ _from_serial(v.as_of_date) },
+							calendar{
+								weekend{ weekend::storage{ v.weekend } },
+								schedule{ period, sorted_unique, _map->get<int32_t>(v.holidays_offset, v.holiday_count), _map },
+								pages,
+								_map
+							}
+						);
+					}
+
+					slot.versions.emplace(std::move(cal_versions));
+					slot.index.emplace(_make_calendar_index(_get_name(c), *slot.versions));
+				}
+			);
+
+			return calendar_handle{ *slot.index };
+		}
+
+		auto calendar_db::locate_calendar(string_view tz_name, year_month_day as_of_date) const -> const calendar&
+		{
+			return locate_calendar_handle(tz_name).locate(as_of_date);
+		}
+
+		auto calendar_db::_get_name(const _calendar_db_calendar& c) const noexcept -> string_view
+		{
+			return string_view{ reinterpret_cast<const char*>(_map->data + c.name_offset), c.name_size };
+		}
+
+		auto calendar_db::_find_calendar(string_view tz_name) const -> size_t
+		{
+			const auto name = [this](const _calendar_db_calendar& c) { return _get_name(c); };
+
+			const auto it = ranges::lower_bound(_calendars, tz_name, {}, name);
+			if (it != _calendars.end() && _get_name(*it) == tz_name)
+				return static_cast<size_t>(it - _calendars.begin());
+			else
+				throw runtime_error{ "calendar "s + string{ tz_name } + " could not be located"s };
+		}
+
+
+
+		struct _used_calendar_dbs final
+		{
+			mutex m;
+			vector<unique_ptr<const calendar_db>> dbs;
+			atomic<const calendar_db*> current{ nullptr };
+		};
+
+		static auto _get_used_calendar_dbs() -> _used_calendar_dbs&
+		{
+			static auto used = _used_calendar_dbs{};
+			return used;
+		}
+
+		void use_calendar_db(const filesystem::path& path)
+		{
+			auto db = make_unique<const calendar_db>(path);
+
+			auto& used = _get_used_calendar_dbs();
+
+			const auto l = lock_guard{ used.m };
+			used.dbs.push_back(std::move(db));
+			used.current.store(used.dbs.back().get(), memory_order_release);
+		}
+
+		void stop_using_calendar_db() noexcept
+		{
+			_get_used_calendar_dbs().current.store(nullptr, memory_order_release);
+		}
+
+		auto _get_calendar_db() noexcept -> const calendar_db*
+		{
+			return _get_used_calendar_dbs().current.load(memory_order_acquire);
+		}
+
+	}
+
+}
@@ -21,6 +21,8 @@
 // SOFTWARE.
 
 #include "makers.h"
+#include "static_data.h"
+#include "calendar_db.h"
 
 #include <calendar.h>
 #include <period.h>
@@ -31,6 +33,21 @@
 #include <chrono>
 #include <cassert>
 #include <iterator>
+#include <vector>
+#include <span>
+#include <memory>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <array>
+#include <optional>
+#include <execution>
+#include <exception>
+#include <utility>
 
 using namespace std;
 using namespace std::chrono;
@@ -45,84 +62,379 @@ namespace gregorian
 	namespace static_data
 	{
 
-		static auto _make_calendar_registry() -> _calendar_registry
+		struct _calendar_maker final
 		{
-			// at the moment we create all calendars (needed or not), which might or might not be what we want
-			// this could be changed to lazy creation if needed, but we'll have to deal with synchronization then
-			return _calendar_registry{
-				{ "Europe/London", make_England_calendar_versions() }, // from UK, only London is in tzdata
-				{ "Europe/Cardif", make_Wales_calendar_versions() },
-                { "Europe/Edinburgh", make_Scotland_calendar_versions() },
-				{ "Europe/Belfast", make_Northern_Ireland_calendar_versions() },
-				{ "Europe/MPC", make_MPC_calendar_versions() }, // or should it be Europe/UK/MPC? or should it be in etcetera?
+			string_view tz_name;
+			auto (*make)() -> _calendar_versions;
+		};
 
-				{ "Europe/T2", make_T2_calendar_versions() }, // or should it be Europe/EU/TARGET2? or should it be in etcetera?
+		// calendars are made on first use, one by one (or in parallel by prewarm), rather than all of them at once
+		static constexpr auto _calendar_makers = array{
+			_calendar_maker{ "Europe/London", &make_England_calendar_versions }, // from UK, only London is in tzdata
+			_calendar_maker{ "Europe/Cardif", &make_Wales_calendar_versions },
+			_calendar_maker{ "Europe/Edinburgh", &make_Scotland_calendar_versions },
+			_calendar_maker{ "Europe/Belfast", &make_Northern_Ireland_calendar_versions },
+			_calendar_maker{ "Europe/MPC", &make_MPC_calendar_versions }, // or should it be Europe/UK/MPC? or should it be in etcetera?
 
-				{ "Europe/Zurich", make_Zurich_calendar_versions() },
+			_calendar_maker{ "Europe/T2", &make_T2_calendar_versions }, // or should it be Europe/EU/TARGET2? or should it be in etcetera?
 
-				{ "Europe/Warsaw", make_Warsaw_calendar_versions() },
+			_calendar_maker{ "Europe/Zurich", &make_Zurich_calendar_versions },
 
-				{ "America/USA", USA::make_Federal_calendar_versions() },
-				{ "America/Washington", USA::make_Washington_DC_Federal_calendar_versions() }, // not a city, but federal holidays // wrong name?
-				{ "America/SIFMA", USA::make_SIFMA_calendar_versions() }, // or should it be America/USA/SIFMA? or should it be in etcetera?
-				{ "America/NFP", USA::make_NFP_calendar_versions() }, // or should it be America/USA/NFP? or should it be in etcetera? Does it need a better name than NFP (also remember that these are release dates)?
-				{ "America/SOFR", USA::make_SOFR_calendar_versions() }, // or should it be America/USA/SOFR? or should it be in etcetera?
+			_calendar_maker{ "Europe/Warsaw", &make_Warsaw_calendar_versions },
 
-				{ "America/Canada", make_Canada_Federal_calendar_versions() },
-				{ "America/Ontario", make_Ontario_calendar_versions() },
-				{ "America/Quebec", make_Quebec_calendar_versions() },
+			_calendar_maker{ "America/USA", &USA::make_Federal_calendar_versions },
+			_calendar_maker{ "America/Washington", &USA::make_Washington_DC_Federal_calendar_versions }, // not a city, but federal holidays // wrong name?
+			_calendar_maker{ "America/SIFMA", &USA::make_SIFMA_calendar_versions }, // or should it be America/USA/SIFMA? or should it be in etcetera?
+			_calendar_maker{ "America/NFP", &USA::make_NFP_calendar_versions }, // or should it be America/USA/NFP? or should it be in etcetera? Does it need a better name than NFP (also remember that these are release dates)?
+			_calendar_maker{ "America/SOFR", &USA::make_SOFR_calendar_versions }, // or should it be America/USA/SOFR? or should it be in etcetera?
 
-				{ "America/ANBIMA", make_ANBIMA_calendar_versions() }, // or should it be America/Brazil/ANBIMA? or should it be in etcetera?
+			_calendar_maker{ "America/Canada", &make_Canada_Federal_calendar_versions },
+			_calendar_maker{ "America/Ontario", &make_Ontario_calendar_versions },
+			_calendar_maker{ "America/Quebec", &make_Quebec_calendar_versions },
 
-				{ "America/CNBV", make_CNBV_calendar_versions() }, // or should it be America/Mexico/CNBV? or should it be in etcetera?
+			_calendar_maker{ "America/ANBIMA", &make_ANBIMA_calendar_versions }, // or should it be America/Brazil/ANBIMA? or should it be in etcetera?
 
-				{ "Asia/Tokyo", make_Tokyo_calendar_versions() },
+			_calendar_maker{ "America/CNBV", &make_CNBV_calendar_versions }, // or should it be America/Mexico/CNBV? or should it be in etcetera?
 
-				{ "Asia/SHIR", make_SHIR_calendar_versions() }, // is this a correct name?
+			_calendar_maker{ "Asia/Tokyo", &make_Tokyo_calendar_versions },
 
-				{ "Africa/Johannesburg", make_Johannesburg_calendar_versions() },
-			};
+			_calendar_maker{ "Asia/SHIR", &make_SHIR_calendar_versions }, // is this a correct name?
+
+			_calendar_maker{ "Africa/Johannesburg", &make_Johannesburg_calendar_versions },
+		};
+
+		// the set of names is fixed, so a seed which hashes all of them to different slots is found at compile time
+		// (so a name is resolved by a single hash and a single string comparison)
+		constexpr auto _calendar_name_hash(const string_view tz_name, const uint64_t seed) noexcept -> uint64_t
+		{
+			auto h = 0xcbf29ce484222325u ^ seed; // FNV-1a
+			for (const auto c : tz_name)
+			{
+				h ^= static_cast<uint8_t>(c);
+				h *= 0x100000001b3u;
+			}
+
+			return h ^ (h >> 32u);
+		}
+
+		static constexpr auto _calendar_name_slots = 64uz; // a power of 2, at least twice the number of names
+		static constexpr auto _no_calendar = uint8_t{ 0xffu };
+
+		static_assert(_calendar_makers.size() * 2uz <= _calendar_name_slots && _calendar_makers.size() < _no_calendar);
+
+		constexpr auto _make_calendar_name_table(const uint64_t seed) noexcept -> optional<array<uint8_t, _calendar_name_slots>>
+		{
+			auto table = array<uint8_t, _calendar_name_slots>{};
+			table.fill(_no_calendar);
+
+			for (auto i = 0uz; i < _calendar_makers.size(); ++i)
+			{
+				auto& slot = table[_calendar_name_hash(_calendar_makers[i].tz_name, seed) & (_calendar_name_slots - 1uz)];
+				if (slot != _no_calendar)
+					return nullopt;
+
+				slot = static_cast<uint8_t>(i);
+			}
+
+			return table;
 		}
 
-		auto _get_calendar_registry() -> const _calendar_registry&
+		constexpr auto _find_calendar_name_seed() noexcept -> uint64_t
 		{
-			static const auto r = _make_calendar_registry(); // ideally all this will be generated at compile time
-			return r;
+			auto seed = uint64_t{ 0u };
+			while (!_make_calendar_name_table(seed))
+				++seed;
+
+			return seed;
 		}
 
+		static constexpr auto _calendar_name_seed = _find_calendar_name_seed();
+		static constexpr auto _calendar_name_table = *_make_calendar_name_table(_calendar_name_seed);
+
+
+		struct _calendar_slot final
+		{
+			once_flag made;
+			optional<_calendar_versions> versions;
+			optional<_calendar_index> index; // of the above
+			atomic<bool> is_made{ false }; // only for _is_calendar_made, call_once takes care of the rest
+		};
 
-		static auto _locate_calendar_versions(string_view tz_name) -> const _calendar_versions&
+		static auto _get_calendar_slots() -> array<_calendar_slot, _calendar_makers.size()>&
 		{
-			const auto& reg = _get_calendar_registry();
+			static auto slots = array<_calendar_slot, _calendar_makers.size()>{};
+			return slots;
+		}
 
-			const auto it = reg.find(tz_name);
-			if (it != reg.cend())
-				return it->second;
+		static auto _find_calendar_maker(string_view tz_name) -> size_t
+		{
+			const auto i = _calendar_name_table[_calendar_name_hash(tz_name, _calendar_name_seed) & (_calendar_name_slots - 1uz)];
+			if (i != _no_calendar && _calendar_makers[i].tz_name == tz_name)
+				return i;
 			else
 				throw runtime_error{ "calendar "s + string{ tz_name } + " could not be located"s };
 		}
 
+		static auto _make_calendar(const size_t i) -> const _calendar_slot&
+		{
+			auto& slot = _get_calendar_slots()[i];
+
+			// if make throws, the next call tries again
+			call_once(
+				slot.made,
+				[&slot, i]()
+				{
+					slot.versions.emplace(_calendar_makers[i].make()); // ideally all this will be generated at compile time
+					slot.index.emplace(_make_calendar_index(_calendar_makers[i].tz_name, *slot.versions));
+					slot.is_made.store(true, memory_order_release);
+				}
+			);
+
+			return slot;
+		}
+
+
+		auto _make_calendar_index(string_view tz_name, const _calendar_versions& cal_versions) -> _calendar_index
+		{
+			auto index = _calendar_index{ .tz_name = tz_name, .as_of_dates = {}, .calendars = {} };
+			index.as_of_dates.reserve(cal_versions.size());
+			index.calendars.reserve(cal_versions.size());
+			for (const auto& [as_of_date, cal] : cal_versions)
+			{
+				index.as_of_dates.push_back(as_of_date);
+				index.calendars.push_back(&cal);
+			}
+
+			return index;
+		}
+
+
+		void _add_calendar_version(_calendar_versions& cal_versions, const year_month_day& as_of_date, const schedule& s)
+		{
+			if (cal_versions.empty() || as_of_date <= cal_versions.crbegin()->first)
+				throw invalid_argument{ "Version has to be after the latest one" };
+
+			auto cal = cal_versions.crbegin()->second.derive(s);
+			cal_versions.emplace_hint(cal_versions.cend(), as_of_date, std::move(cal));
+		}
+
+
+		auto _get_calendar_names() -> vector<string_view>
+		{
+			auto names = vector<string_view>{};
+			names.reserve(_calendar_makers.size());
+			for (const auto& maker : _calendar_makers)
+				names.push_back(maker.tz_name);
+
+			ranges::sort(names);
+			return names;
+		}
+
+		auto _get_calendar_versions(string_view tz_name) -> const _calendar_versions&
+		{
+			return *_make_calendar(_find_calendar_maker(tz_name)).versions;
+		}
+
+		auto _is_calendar_made(string_view tz_name) -> bool
+		{
+			return _get_calendar_slots()[_find_calendar_maker(tz_name)].is_made.load(memory_order_acquire);
+		}
+
+
+		void prewarm(span<const string_view> tz_names)
+		{
+			// all names are checked before anything is made
+			auto is = vector<size_t>{};
+			is.reserve(tz_names.size());
+			for (const auto tz_name : tz_names)
+				is.push_back(_find_calendar_maker(tz_name));
+
+			ranges::sort(is);
+			is.erase(ranges::unique(is).begin(), is.end());
+
+			// exceptions cannot leave a parallel algorithm, so they are rethrown (the first one) after all of them are done
+			auto jobs = vector<pair<size_t, exception_ptr>>{};
+			jobs.reserve(is.size());
+			for (const auto i : is)
+				jobs.emplace_back(i, nullptr);
+
+			std::for_each(
+				execution::par,
+				jobs.begin(),
+				jobs.end(),
+				[](pair<size_t, exception_ptr>& job)
+				{
+					try
+					{
+						static_cast<void>(_make_calendar(job.first));
+					}
+					catch (...)
+					{
+						job.second = current_exception();
+					}
+				}
+			);
+
+			for (const auto& [i, e] : jobs)
+				if (e)
+					rethrow_exception(e);
+		}
+
+		void prewarm()
+		{
+			const auto names = _get_calendar_names();
+			prewarm(names);
+		}
+
+
+		calendar_handle::calendar_handle(const _calendar_index& index) noexcept :
+			_index{ &index }
+		{
+		}
+
+		auto calendar_handle::get_name() const noexcept -> string_view
+		{
+			return _index->tz_name;
+		}
+
+		auto calendar_handle::locate(year_month_day as_of_date) const -> const calendar&
+		{
+			const auto& as_of_dates = _index->as_of_dates;
+			assert(!as_of_dates.empty());
+
+			const auto it = ranges::upper_bound(as_of_dates, as_of_date);
+			if (it != as_of_dates.cbegin())
+				return *_index->calendars[static_cast<size_t>(it - as_of_dates.cbegin()) - 1uz];
+			else
+				throw runtime_error{ "calendar's version as of date "s + string{ _index->tz_name } + " could not be located"s };
+		}
+
+		auto calendar_handle::get_as_of_dates() const noexcept -> span<const year_month_day>
+		{
+			return _index->as_of_dates;
+		}
+
+
+		auto locate_calendar_handle(string_view tz_name) -> calendar_handle
+		{
+			if (const auto* db = _get_calendar_db())
+				return db->locate_calendar_handle(tz_name);
+
+			return calendar_handle{ *_make_calendar(_find_calendar_maker(tz_name)).index };
+		}
+
 		auto locate_calendar(string_view tz_name, year_month_day as_of_date) -> const calendar& // should it be in static_data.cpp?
 		{
-			const auto& cal_versions = _locate_calendar_versions(tz_name);
-			assert(!cal_versions.empty());
+			return locate_calendar_handle(tz_name).locate(as_of_date);
+		}
+
 
-			const auto earliest_as_of_date = cal_versions.cbegin()->first;
-			if (as_of_date >= earliest_as_of_date)
+		// calendar versions a joint calendar is made of (sorted and unique)
+		using _joint_calendar_key = vector<const calendar*>;
+
+		struct _joint_calendar_key_hash final
+		{
+			auto operator()(const _joint_calendar_key& key) const noexcept -> size_t
 			{
-				const auto cal_iter = std::prev(cal_versions.upper_bound(as_of_date));
+				auto h = key.size();
+				for (const auto* cal : key)
+					h ^= hash<const calendar*>{}(cal) + static_cast<size_t>(0x9e3779b97f4a7c15ull) + (h << 6) + (h >> 2);
 
-				return cal_iter->second;
+				return h;
 			}
-			else
-				throw runtime_error{ "calendar's version as of date "s + string{ tz_name } + " could not be located"s };
+		};
+
+		struct _joint_calendar final
+		{
+			_joint_calendar(shared_ptr<const calendar> c, const uint64_t used) noexcept :
+				cal{ std::move(c) },
+				last_used{ used }
+			{
+			}
+
+			shared_ptr<const calendar> cal;
+			mutable atomic<uint64_t> last_used; // updated under a shared lock
+		};
+
+		struct _joint_calendars final
+		{
+			shared_mutex m;
+			unordered_map<_joint_calendar_key, _joint_calendar, _joint_calendar_key_hash> calendars;
+			atomic<uint64_t> clock{ 0u };
+		};
+
+		static auto _get_joint_calendars() -> _joint_calendars&
+		{
+			static auto jcs = _joint_calendars{};
+			return jcs;
 		}
 
+		auto _get_joint_calendars_size() -> size_t
+		{
+			auto& jcs = _get_joint_calendars();
+
+			const auto l = shared_lock{ jcs.m };
+			return jcs.calendars.size();
+		}
+
+		auto locate_joint_calendar(span<const string_view> tz_names, year_month_day as_of_date) -> shared_ptr<const calendar>
+		{
+			if (tz_names.empty())
+				throw invalid_argument{ "There should be at least one calendar to join" };
+
+			auto key = _joint_calendar_key{};
+			key.reserve(tz_names.size());
+			for (const auto tz_name : tz_names)
+				key.push_back(&locate_calendar(tz_name, as_of_date));
+
+			ranges::sort(key);
+			const auto duplicates = ranges::unique(key);
+			key.erase(duplicates.begin(), duplicates.end());
+
+			auto& jcs = _get_joint_calendars();
+
+			{
+				const auto l = shared_lock{ jcs.m };
+
+				const auto it = jcs.calendars.find(key);
+				if (it != jcs.calendars.cend())
+				{
+					it->second.last_used.store(jcs.clock.fetch_add(1u, memory_order_relaxed), memory_order_relaxed);
+					return it->second.cal;
+				}
+			}
+
+			// built outside of the lock (if two threads build the same one, the first one to get the lock wins)
+			auto cal = make_shared<const calendar>(join(key));
+
+			const auto l = unique_lock{ jcs.m };
+
+			auto it = jcs.calendars.find(key);
+			if (it == jcs.calendars.cend())
+			{
+				if (jcs.calendars.size() >= _joint_calendars_capacity)
+				{
+					const auto lru = ranges::min_element(
+						jcs.calendars,
+						{},
+						[](const auto& kv) { return kv.second.last_used.load(memory_order_relaxed); }
+					);
+					jcs.calendars.erase(lru);
+				}
+
+				it = jcs.calendars.try_emplace(std::move(key), std::move(cal), 0u).first;
+			}
+
+			it->second.last_used.store(jcs.clock.fetch_add(1u, memory_order_relaxed), memory_order_relaxed);
+			return it->second.cal;
+		}
+
+
 		// not 100% sure about following tz-data, but it seems to be ok for now
 		// (not sure if continent is important to calendars)
 
-		// we'll probably end up with a separate data file like tz-data (maybe in a similar format)
-		// or an sqlite database
+		// calendars can also come from a separate data file like tz-data (see calendar_db.h),
+		// the make* functions are what it is written from
 
 		// #embed could also be considered, at least for the known dates
 
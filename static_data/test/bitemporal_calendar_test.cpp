@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <bitemporal_calendar.h>
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <calendar.h>
+#include <period.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <span>
+#include <memory>
+#include <execution>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		TEST(static, bitemporal_calendar1)
+		{
+			// the same as locating the version per day
+			const auto h = locate_calendar_handle("Europe/London");
+			const auto bc = bitemporal_calendar{ h };
+			EXPECT_EQ("Europe/London", bc.get_name());
+
+			// Platinum Jubilee, State Funeral of Queen Elizabeth II and Coronation of King Charles III
+			const auto changed = bc.get_changed_days();
+			EXPECT_TRUE(ranges::is_sorted(changed));
+			EXPECT_NE(changed.end(), ranges::find(changed, sys_days{ 2022y / June / 3d }));
+			EXPECT_NE(changed.end(), ranges::find(changed, sys_days{ 2022y / September / 19d }));
+			EXPECT_NE(changed.end(), ranges::find(changed, sys_days{ 2023y / May / 8d }));
+			EXPECT_EQ(changed.end(), ranges::find(changed, sys_days{ 2023y / May / 9d }));
+
+			auto sds = vector<sys_days>{};
+			auto as_of_dates = vector<year_month_day>{};
+			for (const auto as_of_date : h.get_as_of_dates())
+			{
+				const auto& cal = h.locate(as_of_date);
+				const auto& p = cal.get_schedule().get_period();
+				for (auto d = sys_days{ 2018y / January / 1d }; d <= sys_days{ 2030y / December / 31d }; d += days{ 1 })
+				{
+					sds.push_back(d);
+					as_of_dates.push_back(as_of_date);
+					EXPECT_EQ(cal.is_business_day(d), bc.is_business_day(d, as_of_date));
+				}
+
+				const auto whole = util::period{ sys_days{ p.get_from() }, sys_days{ p.get_until() } };
+				EXPECT_EQ(cal.count_business_days(whole), bc.count_business_days(whole, as_of_date));
+
+				const auto years = util::period{ sys_days{ 2022y / January / 1d }, sys_days{ 2023y / December / 31d } };
+				EXPECT_EQ(cal.count_business_days(years), bc.count_business_days(years, as_of_date));
+				EXPECT_EQ(cal.count_business_days(years), bc.count_business_days(years, sys_days{ as_of_date } + days{ 1 }));
+			}
+
+			auto out = make_unique<bool[]>(sds.size());
+			bc.is_business_day(sds, as_of_dates, span{ out.get(), sds.size() });
+			for (auto i = 0uz; i < sds.size(); ++i)
+				EXPECT_EQ(h.locate(as_of_dates[i]).is_business_day(sds[i]), out[i]);
+		}
+
+		TEST(static, bitemporal_calendar2)
+		{
+			// as known before and after the funeral was announced
+			const auto bc = bitemporal_calendar{ locate_calendar_handle("Europe/London") };
+
+			const auto sds = array{ sys_days{ 2022y / September / 19d }, sys_days{ 2022y / September / 19d }, sys_days{ 2022y / September / 16d } };
+			const auto as_of_dates = array{ 2022y / September / 9d, 2022y / September / 10d, 2022y / September / 9d };
+			auto out = array{ false, false, false };
+			bc.is_business_day(sds, as_of_dates, out);
+			EXPECT_TRUE(out[0]);
+			EXPECT_FALSE(out[1]);
+			EXPECT_TRUE(out[2]);
+
+			const auto ps = array{
+				util::period{ sys_days{ 2022y / September / 1d }, sys_days{ 2022y / September / 30d } },
+				util::period{ sys_days{ 2022y / September / 1d }, sys_days{ 2022y / September / 30d } }
+			};
+			const auto as_of_dates2 = array{ 2022y / September / 9d, 2022y / September / 10d };
+			auto counts = array{ 0uz, 0uz };
+			bc.count_business_days(execution::par, ps, as_of_dates2, counts);
+			EXPECT_EQ(22uz, counts[0]);
+			EXPECT_EQ(21uz, counts[1]);
+		}
+
+		TEST(static, bitemporal_calendar3)
+		{
+			const auto bc = bitemporal_calendar{ locate_calendar_handle("Europe/London") };
+
+			EXPECT_THROW((void)bc.is_business_day(sys_days{ 2022y / September / 19d }, 1990y / January / 1d), runtime_error);
+			EXPECT_THROW((void)bc.is_business_day(sys_days{ 2200y / January / 1d }, 2022y / September / 10d), out_of_range);
+			EXPECT_THROW((void)bc.count_business_days(util::period{ sys_days{ 2022y / January / 1d }, sys_days{ 2200y / January / 1d } }, 2022y / September / 10d), out_of_range);
+
+			// nothing is written if any of the pairs is wrong
+			const auto sds = array{ sys_days{ 2022y / September / 19d }, sys_days{ 2200y / January / 1d } };
+			const auto as_of_dates = array{ 2022y / September / 10d, 2022y / September / 10d };
+			auto out = array{ true, true };
+			EXPECT_THROW(bc.is_business_day(sds, as_of_dates, out), out_of_range);
+			EXPECT_TRUE(out[0]);
+
+			auto out1 = array{ true };
+			EXPECT_THROW(bc.is_business_day(sds, as_of_dates, out1), invalid_argument);
+		}
+
+	}
+
+}
@@ -0,0 +1,213 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <calendar_db.h>
+#include <static_data.h>
+#include <makers.h>
+
+#include <gtest/gtest.h>
+
+#include <calendar.h>
+#include <time_series.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <array>
+#include <span>
+#include <optional>
+#include <algorithm>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		static auto _calendar_db_test_path(const string_view name) -> filesystem::path
+		{
+			return filesystem::temp_directory_path() / ("calendar_db_test_"s + string{ name } + ".gcal"s);
+		}
+
+
+		TEST(static, calendar_db1)
+		{
+			// every version of every calendar is the same as the one it was written from
+			const auto path = _calendar_db_test_path("1");
+			write_calendar_db(path);
+
+			const auto db = calendar_db{ path };
+			EXPECT_EQ(_get_calendar_names(), db.get_calendar_names());
+
+			for (const auto tz_name : _get_calendar_names())
+			{
+				const auto& expected = _get_calendar_versions(tz_name);
+
+				const auto handle = db.locate_calendar_handle(tz_name);
+				ASSERT_EQ(expected.size(), handle.get_as_of_dates().size());
+
+				auto as_of = handle.get_as_of_dates().begin();
+				for (const auto& [as_of_date, cal] : expected)
+				{
+					EXPECT_EQ(as_of_date, *as_of);
+
+					const auto& located = db.locate_calendar(tz_name, as_of_date);
+					EXPECT_TRUE(cal == located);
+					EXPECT_EQ(cal.get_weekend(), located.get_weekend());
+					EXPECT_EQ(cal.get_schedule(), located.get_schedule());
+					EXPECT_EQ(&located, &db.locate_calendar(tz_name, as_of_date)); // made once
+					EXPECT_EQ(&located, &handle.locate(as_of_date));
+
+					const auto [f, u] = cal.get_schedule().get_period().from_until();
+					EXPECT_EQ(
+						cal.count_business_days(util::period{ sys_days{ f }, sys_days{ u } }),
+						located.count_business_days(util::period{ sys_days{ f }, sys_days{ u } })
+					);
+
+					++as_of;
+				}
+			}
+
+			EXPECT_THROW(static_cast<void>(db.locate_calendar("foo", 2025y / LastDayOfDecember)), runtime_error);
+			EXPECT_THROW(static_cast<void>(db.locate_calendar("America/ANBIMA", 1999y / LastDayOfDecember)), runtime_error);
+
+			filesystem::remove(path);
+		}
+
+		TEST(static, calendar_db2)
+		{
+			// files which are not calendar databases
+			EXPECT_THROW(static_cast<void>(calendar_db{ _calendar_db_test_path("none") }), runtime_error);
+
+			const auto path = _calendar_db_test_path("2");
+			write_calendar_db(path);
+
+			const auto size = filesystem::file_size(path);
+			filesystem::resize_file(path, size - 1u);
+			EXPECT_THROW(static_cast<void>(calendar_db{ path }), runtime_error);
+
+			{
+				auto out = ofstream{ path, ios::binary | ios::trunc };
+				out << "not a calendar database";
+			}
+			EXPECT_THROW(static_cast<void>(calendar_db{ path }), runtime_error);
+
+			filesystem::remove(path);
+		}
+
+		TEST(static, calendar_db3)
+		{
+			// locate_calendar served from the database
+			const auto path = _calendar_db_test_path("3");
+			write_calendar_db(path);
+
+			const auto& made = locate_calendar("Europe/London", 2024y / June / 1d);
+
+			use_calendar_db(path);
+			filesystem::remove(path); // it stays mapped
+
+			const auto& mapped = locate_calendar("Europe/London", 2024y / June / 1d);
+			EXPECT_NE(&made, &mapped);
+			EXPECT_EQ(&mapped, &locate_calendar_handle("Europe/London").locate(2024y / June / 1d));
+			EXPECT_TRUE(made == mapped);
+			EXPECT_FALSE(mapped.is_business_day(2024y / December / 25d));
+
+			const auto joint = locate_joint_calendar(vector<string_view>{ "Europe/London", "Europe/T2" }, 2024y / June / 1d);
+			EXPECT_FALSE(joint->is_business_day(2024y / May / 1d));
+
+			EXPECT_THROW(static_cast<void>(locate_calendar("foo", 2025y / LastDayOfDecember)), runtime_error);
+
+			stop_using_calendar_db();
+			EXPECT_EQ(&made, &locate_calendar("Europe/London", 2024y / June / 1d));
+			EXPECT_TRUE(made == mapped); // still there
+		}
+
+		TEST(static, calendar_db4)
+		{
+			// calendars refer to the mapped pages, so their copies keep the mapping alive
+			const auto path = _calendar_db_test_path("4");
+			write_calendar_db(path);
+
+			auto copy = optional<calendar>{};
+			{
+				const auto db = calendar_db{ path };
+				copy.emplace(db.locate_calendar("Europe/London", 2024y / June / 1d));
+			}
+			filesystem::remove(path);
+
+			EXPECT_TRUE(*copy == locate_calendar("Europe/London", 2024y / June / 1d));
+			EXPECT_FALSE(copy->is_business_day(2024y / December / 25d));
+
+			// and written to through copies of the pages
+			const auto added = array{ 2024y / June / 3d };
+			const auto derived = copy->derive(added, span<const year_month_day>{});
+			EXPECT_FALSE(derived.is_business_day(2024y / June / 3d));
+			EXPECT_TRUE(copy->is_business_day(2024y / June / 3d));
+			EXPECT_EQ(vector{ sys_days{ 2024y / June / 3d } }, copy->find_differences(derived));
+		}
+
+		TEST(static, calendar_db5)
+		{
+			// versions share the pages the file says they do, which are all the pages they have in common
+			const auto path = _calendar_db_test_path("5");
+			write_calendar_db(path);
+
+			const auto db = calendar_db{ path };
+			const auto page_size = days{ util::time_series<bool>::get_page_size() };
+			for (const auto tz_name : db.get_calendar_names())
+			{
+				const auto handle = db.locate_calendar_handle(tz_name);
+				const calendar* previous = nullptr;
+				for (const auto as_of_date : handle.get_as_of_dates())
+				{
+					const auto& cal = handle.locate(as_of_date);
+					if (previous && previous->get_schedule().get_period() == cal.get_schedule().get_period())
+					{
+						const auto [f, u] = cal.get_schedule().get_period().from_until();
+						const auto pages = static_cast<size_t>((sys_days{ u } - sys_days{ f }) / page_size) + 1uz;
+
+						auto changed = vector<size_t>{};
+						for (const auto d : cal.find_differences(*previous))
+							changed.push_back(static_cast<size_t>((d - sys_days{ f }) / page_size));
+						changed.erase(unique(changed.begin(), changed.end()), changed.end());
+
+						EXPECT_EQ(pages - changed.size(), cal.count_shared_pages(*previous)) << tz_name << ' ' << as_of_date;
+					}
+					previous = &cal;
+				}
+			}
+
+			filesystem::remove(path);
+		}
+
+	}
+
+}
@@ -27,6 +27,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <vector>
 
 using namespace std::chrono;
 
@@ -82,6 +83,26 @@ namespace gregorian
 			EXPECT_EQ(1965y / January / 20d, _InaugurationDay.make_holiday(1965y));
 		}
 
+		TEST(_cyclical_holiday, make_holidays1)
+		{
+			const auto _InaugurationDay = _cyclical_holiday{
+				named_holiday{ January / 20d },
+				1965y,
+				years{ 4 }
+			};
+
+			auto hols = std::vector<year_month_day>(9uz);
+			_InaugurationDay.make_holidays(util::years_period{ 2021y, 2029y }, hols);
+
+			auto y = 2021y;
+			for (const auto& h : hols)
+				EXPECT_EQ(_InaugurationDay.make_holiday(y++).ok(), h.ok());
+
+			EXPECT_EQ(2021y / January / 20d, hols[0]);
+			EXPECT_EQ(2025y / January / 20d, hols[4]);
+			EXPECT_EQ(2029y / January / 20d, hols[8]);
+		}
+
 	}
 
 }
@@ -20,7 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <makers.h>
+#include <static_data.h>
 
 #include <gtest/gtest.h>
 
@@ -41,7 +41,7 @@ namespace gregorian
 			// Override this to define how to set up the environment.
 			void SetUp() override
 			{
-				_get_calendar_registry(); // to initialise the calendars
+				// calendars are made on first use (lazy_locate_calendar_test runs without this environment to check it)
 			}
 
 			// Override this to define how to tear down the environment.
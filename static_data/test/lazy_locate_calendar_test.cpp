@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <static_data.h>
+#include <makers.h>
+
+#include <gtest/gtest.h>
+
+#include <calendar.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <array>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		// this is built into an executable of its own, without the test environment, so no calendar is made to start with
+		// (and each test uses calendars which earlier tests in this file do not)
+
+		TEST(static_lazy, locate_calendar)
+		{
+			for (const auto name : _get_calendar_names())
+				EXPECT_FALSE(_is_calendar_made(name));
+
+			EXPECT_TRUE(locate_calendar("Asia/Tokyo", 2024y / June / 1d).is_business_day(2024y / June / 3d));
+
+			// only the calendar which is located is made
+			for (const auto name : _get_calendar_names())
+				EXPECT_EQ(name == "Asia/Tokyo", _is_calendar_made(name));
+		}
+
+		TEST(static_lazy, prewarm)
+		{
+			EXPECT_FALSE(_is_calendar_made("Europe/London"));
+			EXPECT_FALSE(_is_calendar_made("Europe/Warsaw"));
+
+			// names are checked before anything is made
+			EXPECT_THROW(prewarm(array<string_view, 2>{ "Europe/London", "foo" }), runtime_error);
+			EXPECT_FALSE(_is_calendar_made("Europe/London"));
+
+			prewarm(array<string_view, 1>{ "Europe/Warsaw" });
+			EXPECT_TRUE(_is_calendar_made("Europe/Warsaw"));
+			EXPECT_FALSE(_is_calendar_made("Europe/London"));
+		}
+
+	}
+
+}
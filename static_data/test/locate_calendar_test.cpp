@@ -21,13 +21,25 @@
 // SOFTWARE.
 
 #include <static_data.h>
+#include <makers.h>
 
 #include <gtest/gtest.h>
 
 #include <schedule.h>
+#include <calendar.h>
+#include <time_series.h>
 
 #include <chrono>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <span>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <iterator>
 
 using namespace std;
 using namespace std::chrono;
@@ -68,6 +80,168 @@ namespace gregorian
 			EXPECT_FALSE(cal_ver2.is_business_day(2024y / November / 20d));
 		}
 
+		TEST(static, locate_joint_calendar1)
+		{
+			const auto as_of = 2024y / June / 1d;
+
+			const auto names1 = array<string_view, 3>{ "Europe/London", "America/USA", "Europe/T2" };
+			const auto names2 = array<string_view, 4>{ "Europe/T2", "Europe/London", "America/USA", "Europe/London" };
+
+			const auto cal1 = locate_joint_calendar(names1, as_of);
+			const auto cal2 = locate_joint_calendar(names2, as_of); // the same set of names
+			const auto cal3 = locate_joint_calendar(names1, 2024y / June / 2d); // the same versions
+			EXPECT_EQ(cal1.get(), cal2.get());
+			EXPECT_EQ(cal1.get(), cal3.get());
+
+			const auto expected =
+				locate_calendar("Europe/London", as_of) |
+				locate_calendar("America/USA", as_of) |
+				locate_calendar("Europe/T2", as_of);
+			EXPECT_EQ(expected, *cal1);
+			EXPECT_EQ(expected.get_schedule(), cal1->get_schedule());
+
+			EXPECT_THROW(static_cast<void>(locate_joint_calendar(array<string_view, 2>{ "Europe/London", "foo" }, as_of)), runtime_error);
+			EXPECT_THROW(static_cast<void>(locate_joint_calendar(span<const string_view>{}, as_of)), invalid_argument);
+		}
+
+		TEST(static, locate_joint_calendar2)
+		{
+			// many threads asking for the same joint calendar at once end up with the same one
+			const auto names = array<string_view, 2>{ "Asia/Tokyo", "America/SOFR" };
+			const auto as_of = 2024y / June / 1d;
+
+			auto cals = vector<shared_ptr<const calendar>>(8);
+			{
+				auto threads = vector<jthread>{};
+				for (auto& cal : cals)
+					threads.emplace_back([&cal, &names, as_of]() { cal = locate_joint_calendar(names, as_of); });
+			}
+
+			for (const auto& cal : cals)
+				EXPECT_EQ(cals.front().get(), cal.get());
+		}
+
+		TEST(static, locate_joint_calendar3)
+		{
+			// the cache is bounded, but an evicted calendar stays alive while it is used
+			const auto as_of = 2024y / June / 1d;
+			const auto kept = locate_joint_calendar(array<string_view, 2>{ "Europe/London", "Asia/Tokyo" }, as_of);
+
+			const auto names = _get_calendar_names();
+
+			// more combinations than the capacity (versions of a calendar as of different dates make different ones)
+			auto made = 0uz;
+			for (auto y = 2020y; y <= 2024y && made <= _joint_calendars_capacity; ++y)
+				for (auto i = 0uz; i < names.size() && made <= _joint_calendars_capacity; ++i)
+					for (auto j = i + 1uz; j < names.size() && made <= _joint_calendars_capacity; ++j)
+						for (auto k = j + 1uz; k < names.size() && made <= _joint_calendars_capacity; ++k)
+						{
+							try
+							{
+								static_cast<void>(locate_joint_calendar(array{ names[i], names[j], names[k] }, y / December / 31d));
+								++made;
+							}
+							catch (const exception&)
+							{
+								// not every calendar has a version as of y or periods which overlap
+							}
+						}
+
+			EXPECT_LE(_get_joint_calendars_size(), _joint_calendars_capacity);
+			EXPECT_TRUE(kept->is_business_day(2024y / June / 3d));
+		}
+
+		TEST(static, locate_calendar_handle1)
+		{
+			// every name resolves to itself and names which are not there (but might hash like them) do not resolve
+			for (const auto name : _get_calendar_names())
+			{
+				EXPECT_EQ(name, locate_calendar_handle(name).get_name());
+
+				EXPECT_THROW(static_cast<void>(locate_calendar_handle(name.substr(1uz))), runtime_error);
+				EXPECT_THROW(static_cast<void>(locate_calendar_handle(string{ name } + "/"s)), runtime_error);
+			}
+
+			EXPECT_THROW(static_cast<void>(locate_calendar_handle("")), runtime_error);
+			EXPECT_THROW(static_cast<void>(locate_calendar_handle("foo")), runtime_error);
+		}
+
+		TEST(static, locate_calendar_handle2)
+		{
+			const auto h = locate_calendar_handle("America/ANBIMA");
+
+			// the same versions as located by name
+			const auto& versions = _get_calendar_versions("America/ANBIMA");
+			for (const auto& [as_of_date, cal] : versions)
+			{
+				EXPECT_EQ(&cal, &h.locate(as_of_date));
+				EXPECT_EQ(&locate_calendar("America/ANBIMA", as_of_date), &h.locate(as_of_date));
+			}
+
+			EXPECT_EQ(&locate_calendar("America/ANBIMA", 2023y / December / 20d), &h.locate(2023y / December / 20d));
+			EXPECT_EQ(&locate_calendar("America/ANBIMA", 2023y / December / 21d), &h.locate(2023y / December / 21d));
+			EXPECT_NE(&h.locate(2023y / December / 20d), &h.locate(2023y / December / 21d));
+
+			EXPECT_THROW(static_cast<void>(h.locate(1999y / LastDayOfDecember)), runtime_error);
+		}
+
+		TEST(static, calendar_versions1)
+		{
+			// each version shares all the pages of non business days with the version before it, but the ones with changes
+			const auto tz_names = array<string_view, 5>{ "Europe/London", "Europe/Edinburgh", "Europe/Belfast", "America/USA", "America/Washington" };
+			for (const auto tz_name : tz_names)
+			{
+				const auto& versions = _get_calendar_versions(tz_name);
+				ASSERT_LT(1uz, versions.size());
+
+				for (auto previous = versions.cbegin(), it = std::next(previous); it != versions.cend(); previous = it++)
+				{
+					const auto& cal = it->second;
+					const auto from = sys_days{ cal.get_schedule().get_period().get_from() };
+
+					auto changed = vector<size_t>{};
+					for (const auto& d : cal.find_differences(previous->second))
+						changed.push_back(static_cast<size_t>((d - from).count()) / util::time_series<bool>::get_page_size());
+					const auto duplicates = ranges::unique(changed);
+					changed.erase(duplicates.begin(), duplicates.end());
+
+					EXPECT_EQ(cal.count_shared_pages(cal) - changed.size(), cal.count_shared_pages(previous->second));
+				}
+			}
+		}
+
+		TEST(static, prewarm1)
+		{
+			const auto names = array<string_view, 3>{ "Asia/Tokyo", "Europe/Warsaw", "Asia/Tokyo" };
+			prewarm(names);
+
+			EXPECT_TRUE(_is_calendar_made("Asia/Tokyo"));
+			EXPECT_TRUE(_is_calendar_made("Europe/Warsaw"));
+
+			// the same calendars as located one by one
+			EXPECT_EQ(&_get_calendar_versions("Asia/Tokyo"), &_get_calendar_versions("Asia/Tokyo"));
+			EXPECT_EQ(&locate_calendar("Asia/Tokyo", 2024y / June / 1d), &locate_calendar("Asia/Tokyo", 2024y / June / 1d));
+
+			// (that nothing is made for a wrong name is checked in lazy_locate_calendar_test)
+			EXPECT_THROW(prewarm(array<string_view, 2>{ "Europe/London", "foo" }), runtime_error);
+			EXPECT_THROW(static_cast<void>(_is_calendar_made("foo")), runtime_error);
+
+			EXPECT_NO_THROW(prewarm(span<const string_view>{}));
+		}
+
+		TEST(static, prewarm2)
+		{
+			prewarm();
+
+			const auto names = _get_calendar_names();
+			EXPECT_TRUE(ranges::is_sorted(names));
+			for (const auto name : names)
+			{
+				EXPECT_TRUE(_is_calendar_made(name));
+				EXPECT_FALSE(_get_calendar_versions(name).empty());
+			}
+		}
+
 	}
 
 }
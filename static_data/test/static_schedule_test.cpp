@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <static_schedule.h>
+#include <static_data.h>
+
+#include <annual_holiday_interface.h>
+#include <annual_holidays.h>
+#include <schedule.h>
+#include <calendar.h>
+#include <weekend.h>
+#include <period.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <array>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace gregorian
+{
+
+	namespace static_data
+	{
+
+		constexpr auto _test_period = util::days_period{ 2023y / FirstDayOfJanuary, 2024y / LastDayOfDecember };
+
+		constexpr auto _test_known_holidays = std::array{
+			2023y / May / 2d,
+			2022y / May / 2d, // outside of the period
+			2023y / January / 1d, // the same as generated
+		};
+
+		constexpr auto _test_rules = std::array<const annual_holiday*, 2uz>{ &NewYearsDay, &GoodFriday };
+
+		constexpr auto _test_static_schedule = _make_static_schedule<_count_days(_test_period)>(
+			_test_period,
+			SaturdaySundayWeekend,
+			_test_known_holidays,
+			_test_rules,
+			util::years_period{ 2023y, 2024y }
+		);
+
+
+		TEST(_static_schedule, _count_days)
+		{
+			static_assert(365uz == _count_days(util::days_period{ 2023y / FirstDayOfJanuary, 2023y / LastDayOfDecember }));
+			static_assert(366uz == _count_days(util::days_period{ 2024y / FirstDayOfJanuary, 2024y / LastDayOfDecember }));
+			static_assert(1uz == _count_days(util::days_period{ 2024y / FirstDayOfJanuary, 2024y / FirstDayOfJanuary }));
+		}
+
+		TEST(_static_schedule, _make_static_schedule)
+		{
+			static_assert(12uz == _test_static_schedule.words.size()); // 731 days
+			static_assert(1u == (_test_static_schedule.words[0] & 1u)); // 1 January 2023
+			static_assert(0u == (_test_static_schedule.words[0] & 2u));
+
+			static_assert(0b11000001u == (_test_static_schedule.non_business_days[0] & 0b11111111u)); // 1 January 2023 is Sunday
+			static_assert(0u == (_test_static_schedule.non_business_days.back() >> (731uz % 64uz))); // past the end of the period
+		}
+
+		TEST(_static_schedule, _make_schedule)
+		{
+			const auto s = _make_schedule(_test_static_schedule);
+
+			const auto expected = schedule{
+				_test_period,
+				{
+					2023y / January / 1d,
+					2023y / April / 7d,
+					2023y / May / 2d,
+					2024y / January / 1d,
+					2024y / March / 29d
+				}
+			};
+
+			EXPECT_EQ(expected, s);
+		}
+
+		TEST(_static_schedule, _make_calendar)
+		{
+			const auto cal = _make_calendar(_test_static_schedule);
+
+			const auto expected = calendar{ SaturdaySundayWeekend, _make_schedule(_test_static_schedule) };
+
+			EXPECT_EQ(expected, cal);
+			EXPECT_EQ(expected.count_business_days(_test_period), cal.count_business_days(_test_period));
+			EXPECT_FALSE(cal.is_business_day(2023y / May / 2d));
+			EXPECT_TRUE(cal.is_business_day(2023y / May / 3d));
+
+			// a new version gets its own copy of the page it writes to, the table stays as it is
+			const auto removed = std::array{ 2023y / May / 2d };
+			const auto version = cal.derive({}, removed);
+			EXPECT_TRUE(version.is_business_day(2023y / May / 2d));
+			EXPECT_FALSE(cal.is_business_day(2023y / May / 2d));
+		}
+
+		constexpr auto _test_LabourDay = named_holiday{ May / 1d };
+
+		constexpr auto _test_T2_rules = std::array<const annual_holiday*, 6uz>{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&_test_LabourDay,
+			&ChristmasDay,
+			&BoxingDay
+		};
+
+		constexpr auto _test_T2_period = util::days_period{ 2007y / FirstDayOfJanuary, Epoch.get_until() };
+
+		constexpr auto _test_T2_static_schedule = _make_static_schedule<_count_days(_test_T2_period)>(
+			_test_T2_period,
+			SaturdaySundayWeekend,
+			_test_T2_rules
+		);
+
+		TEST(_static_schedule, locate_calendar)
+		{
+			// made at compile time, the same as made from the rules at run time
+			const auto cal = _make_calendar(_test_T2_static_schedule);
+			const auto& expected = locate_calendar("Europe/T2", 2024y / January / 1d);
+
+			EXPECT_EQ(expected.get_schedule(), cal.get_schedule());
+
+			const auto p = util::days_period{ 2023y / FirstDayOfJanuary, 2024y / LastDayOfDecember };
+			EXPECT_EQ(expected.count_business_days(p), cal.count_business_days(p));
+		}
+
+	}
+
+}
@@ -25,10 +25,15 @@
 #include <schedule.h>
 #include <period.h>
 #include <schedule.h>
+#include <equinoxes_solstices.h>
 
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <array>
+#include <vector>
+#include <stdexcept>
+#include <span>
 
 using namespace std::chrono;
 
@@ -62,6 +67,24 @@ namespace gregorian
 	}
 
 
+	TEST(_orthodox_easter_holiday, make_holiday)
+	{
+		static_assert(2023y / April / 16d == _OrthodoxEaster.make_holiday(2023y));
+		static_assert(2024y / May / 5d == _OrthodoxEaster.make_holiday(2024y));
+		static_assert(2025y / April / 20d == _OrthodoxEaster.make_holiday(2025y));
+		static_assert(2021y / May / 2d == _OrthodoxEaster.make_holiday(2021y));
+		static_assert(1900y / April / 22d == _OrthodoxEaster.make_holiday(1900y));
+	}
+
+	TEST(_easter_holiday, make_holiday_outside_anchor_tables)
+	{
+		for (const auto y : { 1500y, 1582y, 2401y, 3000y })
+		{
+			EXPECT_EQ(_calculate_Easter(y), _Easter.make_holiday(y));
+			EXPECT_EQ(_calculate_Orthodox_Easter(y), _OrthodoxEaster.make_holiday(y));
+		}
+	}
+
 	TEST(offset_holiday, make_holiday_1)
 	{
 		static_assert(2023y / April / 7d == GoodFriday.make_holiday(2023y));
@@ -153,4 +176,135 @@ namespace gregorian
 		EXPECT_EQ(expected, s);
 	}
 
+	TEST(annual_holiday, make_holidays1)
+	{
+		// the same as make_holiday year by year (also for rules which rely on the default _make_holidays)
+		constexpr auto early_may = weekday_indexed_holiday{ May / Monday[1] };
+		constexpr auto spring = weekday_last_holiday{ May / Monday[last] };
+
+		const auto rules = annual_holiday_storage{ &NewYearsDay, &_Easter, &GoodFriday, &WhitMonday, &BoxingDay, &early_may, &spring, &MarchEquinox };
+
+		const auto p = years_period{ 1900y, 2100y };
+		for (const auto& rule : rules)
+		{
+			auto hols = std::vector<year_month_day>(201uz);
+			rule->make_holidays(p, hols);
+
+			auto y = p.get_from();
+			for (const auto& h : hols)
+				EXPECT_EQ(rule->make_holiday(y++), h);
+		}
+	}
+
+	TEST(annual_holiday, make_holidays2)
+	{
+		constexpr auto hols_good_friday = []()
+		{
+			auto hols = std::array<year_month_day, 3uz>{};
+			GoodFriday.make_holidays(years_period{ 2022y, 2024y }, hols);
+			return hols;
+		}();
+
+		static_assert(2022y / April / 15d == hols_good_friday[0]);
+		static_assert(2023y / April / 7d == hols_good_friday[1]);
+		static_assert(2024y / March / 29d == hols_good_friday[2]);
+
+		auto hols = std::array<year_month_day, 2uz>{};
+		EXPECT_THROW(NewYearsDay.make_holidays(years_period{ 2023y, 2023y }, hols), std::invalid_argument);
+		EXPECT_THROW(NewYearsDay.make_holidays(years_period{ 2023y, 2025y }, hols), std::invalid_argument);
+	}
+
+	TEST(annual_holiday, make_holiday_schedule4)
+	{
+		const auto p = years_period{ 1900y, 2100y };
+
+		const auto r = annual_holiday_storage{ &ChristmasDay, &NewYearsDay, &GoodFriday, &EasterMonday, &BoxingDay, &NewYearsDay };
+
+		const auto s = make_holiday_schedule(p, r);
+
+		auto expected = schedule::dates{};
+		for (auto y = p.get_from(); y <= p.get_until(); ++y)
+			for (const auto& rule : r)
+				expected.insert(rule->make_holiday(y));
+
+		EXPECT_EQ(expected, s.get_dates());
+		EXPECT_EQ((days_period{ 1900y / FirstDayOfJanuary, 2100y / LastDayOfDecember }), s.get_period());
+	}
+
+	TEST(annual_holiday, get_anchor)
+	{
+		EXPECT_EQ(&_Easter, GoodFriday.get_anchor());
+		EXPECT_EQ(&ChristmasDay, BoxingDay.get_anchor());
+		EXPECT_EQ(nullptr, NewYearsDay.get_anchor());
+		EXPECT_EQ(nullptr, _Easter.get_anchor());
+
+		const auto anchor_holidays = std::array{ 2023y / December / 25d, 2024y / December / 25d };
+		auto hols = std::array<year_month_day, 2uz>{};
+		BoxingDay.make_holidays(anchor_holidays, hols);
+		EXPECT_EQ((std::array{ 2023y / December / 26d, 2024y / December / 26d }), hols);
+
+		auto fewer_hols = std::array<year_month_day, 1uz>{};
+		EXPECT_THROW(BoxingDay.make_holidays(anchor_holidays, fewer_hols), std::invalid_argument);
+		EXPECT_THROW(ChristmasDay.make_holidays(anchor_holidays, hols), std::invalid_argument);
+	}
+
+
+	class _counted_holiday final : public annual_holiday
+	{
+
+	public:
+
+		mutable int made = 0;
+
+	private:
+
+		auto _make_holiday(const year& y) const noexcept -> year_month_day final
+		{
+			return y / April / 1d;
+		}
+
+		void _make_holidays(const year& from, std::span<year_month_day> output) const noexcept final
+		{
+			++made;
+
+			auto y = from;
+			for (auto& d : output)
+				d = _make_holiday(y++);
+		}
+
+	};
+
+	TEST(annual_holiday, make_holiday_schedule5)
+	{
+		const auto p = years_period{ 2000y, 2009y };
+
+		// the anchor is made once, whether it is one of the rules or not, and however deep the rules are made from it
+		const auto anchor = _counted_holiday{};
+		const auto next_day = offset_holiday{ &anchor, days{ 1 } };
+		const auto day_after_next_day = offset_holiday{ &next_day, days{ 1 } };
+		const auto week_later = offset_holiday{ &anchor, days{ 7 } };
+
+		const auto r1 = annual_holiday_storage{ &day_after_next_day, &next_day, &week_later };
+		const auto s1 = make_holiday_schedule(p, r1);
+		EXPECT_EQ(1, anchor.made);
+
+		const auto r2 = annual_holiday_storage{ &next_day, &anchor, &week_later, &day_after_next_day };
+		const auto s2 = make_holiday_schedule(p, r2);
+		EXPECT_EQ(2, anchor.made);
+
+		auto expected1 = schedule::dates{};
+		for (auto y = p.get_from(); y <= p.get_until(); ++y)
+			for (const auto& rule : r1)
+				expected1.insert(rule->make_holiday(y));
+
+		EXPECT_EQ(expected1, s1.get_dates());
+		EXPECT_EQ(30uz, s1.get_dates().size());
+
+		auto expected2 = expected1;
+		for (auto y = p.get_from(); y <= p.get_until(); ++y)
+			expected2.insert(y / April / 1d);
+
+		EXPECT_EQ(expected2, s2.get_dates());
+	}
+
 }
@@ -201,6 +201,69 @@ namespace gregorian
 		EXPECT_THROW(static_cast<void>(Nearest.adjust(c.get_schedule().get_period().get_until(), c)), out_of_range);
 	}
 
+	TEST(business_day_adjuster, adjust1)
+	{
+		// built-in adjusters give the same through their own type (static dispatch), through business_day_adjuster& and by convention
+
+		static_assert(business_day_adjuster_type<following>);
+		static_assert(business_day_adjuster_type<business_day_adjuster>);
+		static_assert(!business_day_adjuster_type<int>);
+
+		const auto& c = make_calendar_england();
+
+		const auto check = [&c](const auto& a, const business_day_convention convention)
+		{
+			const business_day_adjuster& v = a;
+			for (auto d = sys_days{ 2022y / December / 1d }; d <= sys_days{ 2023y / January / 31d }; d += days{ 1 })
+			{
+				EXPECT_EQ(a.adjust(d, c), v.adjust(d, c));
+				EXPECT_EQ(a.adjust(d, c), adjust(d, convention, c));
+				EXPECT_EQ(a.adjust(year_month_day{ d }, c), v.adjust(year_month_day{ d }, c));
+				EXPECT_EQ(a.adjust(year_month_day{ d }, c), adjust(year_month_day{ d }, convention, c));
+			}
+		};
+
+		check(NoAdjustment, business_day_convention::no_adjustment);
+		check(Following, business_day_convention::following);
+		check(Preceding, business_day_convention::preceding);
+		check(Nearest, business_day_convention::nearest);
+
+		const auto invalid = static_cast<business_day_convention>(42);
+		EXPECT_THROW(static_cast<void>(adjust(sys_days{ 2022y / December / 1d }, invalid, c)), invalid_argument);
+		EXPECT_THROW(static_cast<void>(adjust(2022y / December / 1d, invalid, c)), invalid_argument);
+	}
+
+	TEST(business_day_adjuster, adjust2)
+	{
+		// user-defined adjusters still go through the virtual interface (e.g. with calendar::substitute)
+
+		class two_days_later final : public business_day_adjuster
+		{
+		private:
+			auto _adjust(const year_month_day& ymd, const calendar& cal) const -> year_month_day final
+			{
+				return sys_days{ ymd } + days{ 2 };
+			}
+		};
+
+		const auto a = two_days_later{};
+		const business_day_adjuster& v = a;
+
+		const auto& c = make_calendar_england();
+		EXPECT_EQ(2023y / January / 3d, v.adjust(2023y / January / 1d, c));
+		EXPECT_EQ(sys_days{ 2023y / January / 3d }, v.adjust(sys_days{ 2023y / January / 1d }, c));
+
+		auto cal = calendar{
+			SaturdaySundayWeekend,
+			schedule{
+				util::days_period{ 2023y / January / 1d, 2023y / January / 31d },
+				schedule::dates{ 2023y / January / 14d } // Saturday
+			}
+		};
+		cal.substitute(v);
+		EXPECT_EQ((schedule::dates{ 2023y / January / 16d }), cal.get_schedule().get_dates());
+	}
+
 	TEST(make_first_business_day, make_first_business_day)
 	{
 		const auto& c = make_calendar_england();
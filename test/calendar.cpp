@@ -31,7 +31,15 @@
 #include <gtest/gtest.h>
 
 #include <stdexcept>
+#include <vector>
+#include <array>
+#include <span>
+#include <memory>
+#include <algorithm>
+#include <execution>
+#include <system_error>
 #include <chrono>
+#include <cstdint>
 
 #include "setup.h"
 
@@ -111,6 +119,41 @@ namespace gregorian
 		EXPECT_EQ(c_expected, c);
 	}
 
+	TEST(calendar, constructor4)
+	{
+		// prebuilt non business days
+
+		const auto s = schedule{
+			period{ 2023y / January / 1d, 2023y / January / 31d },
+			schedule::dates{
+				2023y / January / 2d,
+			}
+		};
+
+		const auto c_expected = calendar{
+			SaturdaySundayWeekend,
+			s
+		};
+
+		auto words = vector<uint64_t>(1uz);
+		for (auto i = 0u; i < 31u; ++i)
+			if (c_expected.is_non_business_day(sys_days{ 2023y / January / 1d } + days{ i }))
+				words.front() |= uint64_t{ 1u } << i;
+
+		const auto c = calendar{
+			SaturdaySundayWeekend,
+			s,
+			span<const uint64_t>{ words }
+		};
+
+		EXPECT_EQ(c_expected, c);
+		EXPECT_FALSE(c.is_business_day(2023y / January / 2d));
+		EXPECT_TRUE(c.is_business_day(2023y / January / 3d));
+
+		words.push_back(0u);
+		EXPECT_THROW(static_cast<void>(calendar(SaturdaySundayWeekend, s, span<const uint64_t>{ words })), invalid_argument);
+	}
+
 	TEST(calendar, substitute1)
 	{
 		const auto expected = calendar{
@@ -151,6 +194,166 @@ namespace gregorian
 		EXPECT_THROW(c.substitute(Nearest), out_of_range); // stepping outside of the schedule period
 	}
 
+	TEST(calendar, substitute3)
+	{
+		// two centuries of generated holidays, compared with a holiday by holiday substitution
+		const auto rules = annual_holiday_storage{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&ChristmasDay,
+			&BoxingDay
+		};
+		const auto s = make_holiday_schedule(years_period{ 1950y, 2149y }, rules);
+
+		const auto original = calendar{ SaturdaySundayWeekend, s };
+
+		auto expected_hols = schedule{ s.get_period(), schedule::dates{} };
+		for (const auto& holiday : s.get_dates())
+			expected_hols += SaturdaySundayWeekend.is_weekend(holiday) ? Following.adjust(year_month_day{ holiday }, original) : year_month_day{ holiday };
+
+		auto c = original;
+		c.substitute(Following);
+
+		EXPECT_EQ(expected_hols, c.get_schedule());
+		EXPECT_EQ((calendar{ SaturdaySundayWeekend, expected_hols, calendar::caching::eager }), c);
+
+		// Christmas on Saturday and Boxing Day on Sunday are both substituted by Monday
+		EXPECT_TRUE(c.get_schedule().contains(2021y / December / 27d));
+		EXPECT_FALSE(c.get_schedule().contains(2021y / December / 28d));
+	}
+
+	TEST(calendar, share_non_business_days1)
+	{
+		// versions which differ by a holiday share all the pages but the one with it
+		const auto rules = annual_holiday_storage{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&ChristmasDay,
+			&BoxingDay
+		};
+		const auto s = make_holiday_schedule(years_period{ 2000y, 2099y }, rules);
+
+		const auto cal1 = calendar{ SaturdaySundayWeekend, s };
+		auto s2 = s;
+		s2 += 2024y / June / 3d;
+		auto cal2 = calendar{ SaturdaySundayWeekend, s2 };
+
+		const auto pages = (static_cast<size_t>((sys_days{ s.get_period().get_until() } - sys_days{ s.get_period().get_from() }).count()) + time_series<bool>::get_page_size()) / time_series<bool>::get_page_size();
+		EXPECT_EQ(pages - 1uz, cal2.share_non_business_days(cal1));
+
+		EXPECT_TRUE(cal1.is_business_day(2024y / June / 3d));
+		EXPECT_FALSE(cal2.is_business_day(2024y / June / 3d));
+		EXPECT_EQ(cal1.count_business_days(s.get_period()), cal2.count_business_days(s.get_period()) + 1uz);
+		EXPECT_EQ((calendar{ SaturdaySundayWeekend, cal2.get_schedule(), calendar::caching::eager }), cal2);
+	}
+
+	TEST(calendar, derive1)
+	{
+		const auto rules = annual_holiday_storage{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&ChristmasDay,
+			&BoxingDay
+		};
+		const auto s = make_holiday_schedule(years_period{ 2000y, 2099y }, rules);
+
+		const auto added = array{ 2024y / June / 3d, 2024y / June / 8d }; // 8th is Saturday
+		const auto removed = array{ 2024y / April / 1d, 2026y / December / 26d }; // 26th is Saturday
+
+		auto s2 = s;
+		s2 += added[0];
+		s2 += added[1];
+		s2 -= removed[0];
+		s2 -= removed[1];
+
+		for (const auto c : { calendar::caching::lazy, calendar::caching::eager })
+		{
+			const auto cal1 = calendar{ SaturdaySundayWeekend, s, c };
+			const auto cal2 = cal1.derive(added, removed);
+
+			EXPECT_EQ(s, cal1.get_schedule());
+			EXPECT_EQ(s2, cal2.get_schedule());
+
+			const auto expected = calendar{ SaturdaySundayWeekend, s2, calendar::caching::eager };
+			EXPECT_EQ(expected, cal2);
+			EXPECT_EQ(expected.count_business_days(s.get_period()), cal2.count_business_days(s.get_period()));
+			EXPECT_EQ(expected.count_business_days_before(sys_days{ 2030y / January / 1d }), cal2.count_business_days_before(sys_days{ 2030y / January / 1d }));
+			EXPECT_FALSE(cal2.is_business_day(2024y / June / 3d));
+			EXPECT_TRUE(cal2.is_business_day(2024y / April / 1d));
+			EXPECT_FALSE(cal2.is_business_day(2026y / December / 26d));
+			EXPECT_TRUE(cal1.is_business_day(2024y / June / 3d));
+			EXPECT_FALSE(cal1.is_business_day(2024y / April / 1d));
+		}
+	}
+
+	TEST(calendar, derive2)
+	{
+		const auto rules = annual_holiday_storage{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&ChristmasDay,
+			&BoxingDay
+		};
+
+		// a year of announced holidays replaces the generated one
+		const auto announced = schedule{
+			days_period{ 2024y / FirstDayOfJanuary, 2024y / LastDayOfDecember },
+			schedule::dates{
+				2024y / January / 1d,
+				2024y / March / 29d,
+				2024y / June / 3d,
+				2024y / December / 25d,
+				2024y / December / 26d,
+			}
+		};
+
+		const auto cal1 = calendar{ SaturdaySundayWeekend, make_holiday_schedule(years_period{ 2000y, 2099y }, rules) };
+		const auto cal2 = cal1.derive(announced);
+
+		const auto expected = calendar{
+			SaturdaySundayWeekend,
+			make_holiday_schedule(years_period{ 2000y, 2023y }, rules) +
+			announced +
+			make_holiday_schedule(years_period{ 2025y, 2099y }, rules)
+		};
+		EXPECT_EQ(expected.get_schedule(), cal2.get_schedule());
+		EXPECT_EQ(expected, cal2);
+		EXPECT_EQ(expected.count_business_days(cal1.get_schedule().get_period()), cal2.count_business_days(cal1.get_schedule().get_period()));
+
+		// nothing changes
+		EXPECT_EQ(cal2, cal2.derive(announced));
+		EXPECT_EQ(cal1, cal1.derive(span<const year_month_day>{}, span<const year_month_day>{}));
+	}
+
+	TEST(calendar, derive3)
+	{
+		const auto cal = calendar{
+			SaturdaySundayWeekend,
+			schedule{
+				days_period{ 2023y / January / 1d, 2023y / January / 31d },
+				schedule::dates{
+					2023y / January / 2d,
+				}
+			}
+		};
+
+		const auto outside = array{ 2023y / February / 1d };
+		EXPECT_THROW((void)cal.derive(outside, {}), out_of_range);
+		EXPECT_THROW((void)cal.derive({}, outside), out_of_range);
+
+		const auto invalid = array{ 2023y / January / 32d };
+		EXPECT_THROW((void)cal.derive(invalid, {}), invalid_argument);
+
+		const auto both = array{ 2023y / January / 3d };
+		EXPECT_THROW((void)cal.derive(both, both), invalid_argument);
+
+		EXPECT_THROW((void)cal.derive(schedule{ days_period{ 2023y / January / 1d, 2023y / February / 1d }, schedule::dates{} }), out_of_range);
+	}
+
 	TEST(calendar, get_weekend)
 	{
 		const auto s = schedule{
@@ -229,6 +432,34 @@ namespace gregorian
 		EXPECT_TRUE(c.is_business_day(sys_days{ 2023y / February / 30d })); // not .ok()
 	}
 
+	TEST(calendar, is_business_day_unchecked1)
+	{
+		const auto& c = make_calendar_england();
+
+		EXPECT_FALSE(c.is_business_day_unchecked(2023y / May / 1d));
+		EXPECT_TRUE(c.is_business_day_unchecked(2023y / May / 2d));
+		EXPECT_FALSE(c.is_business_day_unchecked(sys_days{ 2023y / May / 1d }));
+		EXPECT_TRUE(c.is_business_day_unchecked(sys_days{ 2023y / May / 2d }));
+	}
+
+	TEST(calendar, try_is_business_day1)
+	{
+		const auto& c = make_calendar_england();
+
+		EXPECT_EQ(false, c.try_is_business_day(2023y / May / 1d));
+		EXPECT_EQ(true, c.try_is_business_day(2023y / May / 2d));
+		EXPECT_EQ(false, c.try_is_business_day(sys_days{ 2023y / May / 1d }));
+		EXPECT_EQ(true, c.try_is_business_day(sys_days{ 2023y / May / 2d }));
+
+		const auto r1 = c.try_is_business_day(1y / May / 1d);
+		ASSERT_FALSE(r1.has_value());
+		EXPECT_EQ(errc::argument_out_of_domain, r1.error());
+
+		const auto r2 = c.try_is_business_day(sys_days{ 9999y / May / 1d });
+		ASSERT_FALSE(r2.has_value());
+		EXPECT_EQ(errc::argument_out_of_domain, r2.error());
+	}
+
 	TEST(calendar, count_business_days1)
 	{
 		const auto& c = make_calendar_england();
@@ -391,6 +622,155 @@ namespace gregorian
 		// we assume 64 days in a chunk
 	}
 
+	TEST(calendar, is_business_day_batch1)
+	{
+		const auto& c = make_calendar_england();
+		const auto& cp = c.get_schedule().get_period();
+
+		auto sds = vector<sys_days>{};
+		for (auto sd = sys_days{ cp.get_from() }; sd <= sys_days{ cp.get_until() }; sd += days{ 3 })
+			sds.push_back(sd);
+		ranges::reverse(sds); // order does not matter
+
+		auto out1 = make_unique<bool[]>(sds.size());
+		c.is_business_day(sds, span{ out1.get(), sds.size() });
+
+		auto out2 = make_unique<bool[]>(sds.size());
+		c.is_business_day(execution::par, sds, span{ out2.get(), sds.size() });
+
+		for (auto i = 0uz; i < sds.size(); ++i)
+		{
+			EXPECT_EQ(c.is_business_day(sds[i]), out1[i]);
+			EXPECT_EQ(c.is_business_day(sds[i]), out2[i]);
+		}
+
+		// nothing is written if any of the days is outside of the calendar
+		auto out3 = array<bool, 3>{ true, true, true };
+		const auto bad = array<sys_days, 3>{ sys_days{ 2023y / May / 1d }, sys_days{ cp.get_until() } + days{ 1 }, sys_days{ 2023y / May / 2d } };
+		EXPECT_THROW(c.is_business_day(bad, out3), out_of_range);
+		EXPECT_EQ((array<bool, 3>{ true, true, true }), out3);
+
+		auto out4 = array<bool, 2>{};
+		EXPECT_THROW(c.is_business_day(span{ bad }, out4), invalid_argument);
+
+		c.is_business_day(span<const sys_days>{}, span<bool>{}); // empty is fine
+	}
+
+	TEST(calendar, caching1)
+	{
+		const auto& s = make_holiday_schedule_england();
+		const auto& p = s.get_period();
+
+		auto lazy = calendar{ SaturdaySundayWeekend, s, calendar::caching::lazy };
+		auto eager = calendar{ SaturdaySundayWeekend, s, calendar::caching::eager };
+
+		// substitution only populates the blocks it writes to
+		lazy.substitute(Following);
+		eager.substitute(Following);
+
+		const auto f = sys_days{ p.get_from() };
+		const auto u = sys_days{ p.get_until() };
+		for (auto d = f; d <= u; d += days{ 1 })
+		{
+			EXPECT_EQ(eager.is_business_day(d), lazy.is_business_day(d));
+			EXPECT_EQ(eager.count_business_days(period{ f, d }), lazy.count_business_days(period{ f, d }));
+		}
+
+		EXPECT_EQ(eager, lazy);
+		EXPECT_EQ(eager, (calendar{ SaturdaySundayWeekend, lazy.get_schedule(), calendar::caching::eager }));
+	}
+
+	TEST(calendar, caching2)
+	{
+		// a lazy calendar shared between threads (they all populate blocks as they go)
+		const auto& s = make_holiday_schedule_england();
+		const auto& cp = s.get_period();
+
+		const auto lazy = calendar{ SaturdaySundayWeekend, s, calendar::caching::lazy };
+		const auto eager = calendar{ SaturdaySundayWeekend, s, calendar::caching::eager };
+
+		auto sds = vector<sys_days>{};
+		for (auto sd = sys_days{ cp.get_from() }; sd <= sys_days{ cp.get_until() }; sd += days{ 1 })
+			sds.push_back(sd);
+		ranges::reverse(sds);
+
+		auto out = make_unique<bool[]>(sds.size());
+		lazy.is_business_day(execution::par, sds, span{ out.get(), sds.size() });
+
+		for (auto i = 0uz; i < sds.size(); ++i)
+			EXPECT_EQ(eager.is_business_day(sds[i]), out[i]);
+	}
+
+	TEST(calendar, count_business_days_batch1)
+	{
+		const auto& c = make_calendar_england();
+		const auto& cp = c.get_schedule().get_period();
+
+		auto ps = vector<period<sys_days>>{};
+		for (auto sd = sys_days{ cp.get_from() }; sd + days{ 400 } <= sys_days{ cp.get_until() }; sd += days{ 17 })
+			ps.emplace_back(sd, sd + days{ (sd - sys_days{ cp.get_from() }).count() % 400 });
+
+		auto out1 = vector<size_t>(ps.size());
+		c.count_business_days(ps, out1);
+
+		auto out2 = vector<size_t>(ps.size());
+		c.count_business_days(execution::par, ps, out2);
+
+		for (auto i = 0uz; i < ps.size(); ++i)
+		{
+			EXPECT_EQ(c.count_business_days(ps[i]), out1[i]);
+			EXPECT_EQ(c.count_business_days(ps[i]), out2[i]);
+		}
+
+		ps.emplace_back(sys_days{ cp.get_from() } - days{ 1 }, sys_days{ cp.get_from() });
+		out1.push_back(0uz);
+		EXPECT_THROW(c.count_business_days(ps, out1), out_of_range);
+		EXPECT_THROW(c.count_business_days(ps, span{ out1 }.first(1)), invalid_argument);
+	}
+
+	TEST(calendar, next_previous_nearest_business_day1)
+	{
+		const auto& c = make_calendar_england();
+		const auto& p = c.get_schedule().get_period();
+
+		const auto from = sys_days{ p.get_from() };
+		const auto until = sys_days{ p.get_until() };
+
+		// one day at a time
+		const auto next = [&c](sys_days sd) { while (!c.is_business_day(sd)) sd += days{ 1 }; return sd; };
+		const auto previous = [&c](sys_days sd) { while (!c.is_business_day(sd)) sd -= days{ 1 }; return sd; };
+
+		for (auto sd = from + days{ 7 }; sd <= until - days{ 7 }; sd += days{ 1 })
+		{
+			const auto n = next(sd);
+			const auto pr = previous(sd);
+			EXPECT_EQ(n, c.next_business_day(sd));
+			EXPECT_EQ(pr, c.previous_business_day(sd));
+			EXPECT_EQ(n - sd <= sd - pr ? n : pr, c.nearest_business_day(sd));
+		}
+	}
+
+	TEST(calendar, next_previous_nearest_business_day2)
+	{
+		const auto& c1 = make_calendar_starts_ends_with_holidays();
+		const auto from = sys_days{ c1.get_schedule().get_period().get_from() };
+		const auto until = sys_days{ c1.get_schedule().get_period().get_until() };
+
+		EXPECT_EQ(from + days{ 1 }, c1.next_business_day(from));
+		EXPECT_EQ(until - days{ 1 }, c1.previous_business_day(until));
+		EXPECT_THROW(static_cast<void>(c1.next_business_day(until)), out_of_range);
+		EXPECT_THROW(static_cast<void>(c1.previous_business_day(from)), out_of_range);
+		EXPECT_THROW(static_cast<void>(c1.nearest_business_day(from)), out_of_range);
+		EXPECT_THROW(static_cast<void>(c1.nearest_business_day(until)), out_of_range);
+		EXPECT_THROW(static_cast<void>(c1.next_business_day(until + days{ 1 })), out_of_range);
+		EXPECT_EQ(from + days{ 100 }, c1.nearest_business_day(from + days{ 100 }));
+
+		const auto& c2 = make_calendar_all_holidays();
+		EXPECT_THROW(static_cast<void>(c2.next_business_day(sys_days{ c2.get_schedule().get_period().get_from() })), out_of_range);
+		EXPECT_THROW(static_cast<void>(c2.previous_business_day(sys_days{ c2.get_schedule().get_period().get_until() })), out_of_range);
+		EXPECT_THROW(static_cast<void>(c2.nearest_business_day(sys_days{ 2024y / June / 1d })), out_of_range);
+	}
+
 	TEST(calendar, make_business_days_schedule1)
 	{
 		const auto& c = make_calendar_england();
@@ -527,6 +907,22 @@ namespace gregorian
 		EXPECT_EQ(expected_s6, s6);
 	}
 
+	TEST(calendar, make_business_days_schedule3)
+	{
+		const auto& c = make_calendar_england();
+		const auto& cp = c.get_schedule().get_period();
+
+		EXPECT_THROW(
+			static_cast<void>(c.make_business_days_schedule(days_period{ sys_days{ cp.get_from() } - days{ 1 }, cp.get_until() })),
+			out_of_range
+		);
+		EXPECT_THROW(
+			static_cast<void>(c.make_business_days_schedule(days_period{ cp.get_from(), sys_days{ cp.get_until() } + days{ 1 } })),
+			out_of_range
+		);
+		EXPECT_EQ(c.count_business_days(cp), c.make_business_days_schedule(cp).get_dates().size());
+	}
+
 	TEST(calendar, make_business_days_schedule2)
 	{
 		const auto& c = make_calendar_england();
@@ -849,4 +1245,67 @@ namespace gregorian
 		EXPECT_EQ(expected, c1 | c2);
 	}
 
+	TEST(calendar, join1)
+	{
+		// different periods, weekends and holidays - each day is checked against all the inputs
+		const auto c1 = calendar{
+			SaturdaySundayWeekend,
+			schedule{ period{ 2018y / January / 1d, 2031y / December / 31d }, make_holiday_schedule_england().get_dates() },
+			calendar::caching::eager
+		};
+		const auto c2 = calendar{
+			FridaySaturdayWeekend,
+			schedule{ period{ 2017y / March / 3d, 2029y / May / 17d }, schedule::dates{ 2019y / January / 2d, 2021y / July / 5d } },
+			calendar::caching::eager
+		};
+		const auto c3 = calendar{
+			SundayWeekend,
+			schedule{ period{ 2019y / January / 1d, 2030y / December / 31d }, schedule::dates{ 2019y / January / 1d, 2024y / February / 29d } },
+			calendar::caching::eager
+		};
+
+		const auto cals = array{ &c1, &c2, &c3 };
+		const auto joint = join(cals);
+
+		const auto& p = joint.get_schedule().get_period();
+		EXPECT_EQ((days_period{ 2019y / January / 1d, 2029y / May / 17d }), p);
+		EXPECT_EQ(SaturdaySundayWeekend | FridaySaturdayWeekend, joint.get_weekend());
+
+		for (auto d = sys_days{ p.get_from() }; d <= sys_days{ p.get_until() }; d += days{ 1 })
+			EXPECT_EQ(c1.is_non_business_day(d) || c2.is_non_business_day(d) || c3.is_non_business_day(d), joint.is_non_business_day(d));
+
+		// the same as made from the weekend and schedule, or as a fold of |
+		EXPECT_EQ((calendar{ joint.get_weekend(), joint.get_schedule(), calendar::caching::eager }), joint);
+		EXPECT_EQ(c1 | c2 | c3, joint);
+		EXPECT_EQ((c1 | c2 | c3).get_schedule(), joint.get_schedule());
+
+		// lazy inputs
+		const auto l1 = calendar{ c1.get_weekend(), c1.get_schedule() };
+		const auto l2 = calendar{ c2.get_weekend(), c2.get_schedule() };
+		EXPECT_EQ(c1 | c2, l1 | l2);
+		EXPECT_EQ(c1 | c2, c1 | l2);
+
+		EXPECT_EQ(c2, join(array{ &c2 }));
+		EXPECT_THROW(static_cast<void>(join(span<const calendar* const>{})), invalid_argument);
+	}
+
+	TEST(calendar, operator_bitwise_and_2)
+	{
+		const auto& c = make_calendar_england();
+		const auto s = schedule{
+			period{ 2019y / January / 1d, 2025y / December / 31d },
+			schedule::dates{ 2019y / January / 1d, 2020y / January / 1d, 2020y / January / 2d }
+		};
+
+		// the same weekends (word by word and) and different ones
+		for (const auto& we : { SaturdaySundayWeekend, SundayWeekend })
+		{
+			const auto other = calendar{ we, s, calendar::caching::eager };
+			const auto both = c & other;
+
+			EXPECT_EQ((calendar{ c.get_weekend() & we, c.get_schedule() & s, calendar::caching::eager }), both);
+			EXPECT_EQ(c.get_schedule() & s, both.get_schedule());
+		}
+	}
+
 }
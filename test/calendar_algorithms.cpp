@@ -21,10 +21,15 @@
 // SOFTWARE.
 
 #include <calendar_algorithms.h>
+#include <business_day_adjusters.h>
 
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <span>
+#include <execution>
 
 #include "setup.h"
 
@@ -62,4 +67,101 @@ namespace gregorian
 		EXPECT_EQ(shift_business_days(sys_days{ 2023y / May / 1d }, days{ -1 }, c), sys_days{ 2023y / April / 28d });
 	}
 
+	TEST(calendar_algorithms, shift_business_days3)
+	{
+		const auto& c = make_calendar_england();
+
+		// step one business day at a time
+		const auto step = [&c](sys_days sd, const days::rep n)
+		{
+			for (auto i = days::rep{ 0 }; i < n; ++i)
+				sd = Following.adjust(sd + days{ 1 }, c);
+			for (auto i = days::rep{ 0 }; i > n; --i)
+				sd = Preceding.adjust(sd - days{ 1 }, c);
+			return sd;
+		};
+
+		const auto from = sys_days{ 2022y / December / 1d };
+		const auto until = sys_days{ 2023y / February / 28d };
+		for (auto sd = from; sd <= until; sd += days{ 1 })
+			for (const auto n : { -300, -63, -22, -5, -1, 0, 1, 5, 22, 63, 300 })
+				EXPECT_EQ(step(sd, n), shift_business_days(sd, days{ n }, c));
+	}
+
+	TEST(calendar_algorithms, shift_business_days4)
+	{
+		const auto& c = make_calendar_england();
+		const auto& p = c.get_schedule().get_period();
+
+		const auto from = sys_days{ p.get_from() };
+		const auto until = sys_days{ p.get_until() };
+
+		const auto business_days = c.count_business_days(p);
+
+		// the whole calendar in one go (and just a bit too much)
+		const auto first = Following.adjust(from, c);
+		const auto last = Preceding.adjust(until, c);
+		EXPECT_EQ(last, shift_business_days(first, days{ static_cast<days::rep>(business_days) - 1 }, c));
+		EXPECT_EQ(first, shift_business_days(last, days{ 1 - static_cast<days::rep>(business_days) }, c));
+		EXPECT_THROW(static_cast<void>(shift_business_days(first, days{ static_cast<days::rep>(business_days) }, c)), std::out_of_range);
+		EXPECT_THROW(static_cast<void>(shift_business_days(last, days{ -static_cast<days::rep>(business_days) }, c)), std::out_of_range);
+
+		// a day outside of the calendar
+		EXPECT_THROW(static_cast<void>(shift_business_days(until, days{ 1 }, c)), std::out_of_range);
+		EXPECT_THROW(static_cast<void>(shift_business_days(from, days{ -1 }, c)), std::out_of_range);
+	}
+
+	TEST(calendar_algorithms, count_business_days_before1)
+	{
+		const auto& c = make_calendar_england();
+		const auto& p = c.get_schedule().get_period();
+
+		const auto from = sys_days{ p.get_from() };
+
+		auto n = 0uz;
+		for (auto sd = from; sd <= from + days{ 400 }; sd += days{ 1 })
+		{
+			EXPECT_EQ(n, c.count_business_days_before(sd));
+			if (c.is_business_day(sd))
+				EXPECT_EQ(sd, c.nth_business_day(n++));
+		}
+	}
+
+	TEST(calendar_algorithms, shift_business_days_batch1)
+	{
+		const auto& c = make_calendar_england();
+
+		auto sds = std::vector<sys_days>{};
+		for (auto sd = sys_days{ 2022y / December / 1d }; sd <= sys_days{ 2023y / December / 1d }; sd += days{ 1 })
+			sds.push_back(sd);
+
+		for (const auto n : { -22, -1, 0, 1, 2, 22 })
+		{
+			auto out1 = std::vector<sys_days>(sds.size());
+			shift_business_days(sds, days{ n }, c, out1);
+
+			auto out2 = std::vector<sys_days>(sds.size());
+			shift_business_days(std::execution::par, sds, days{ n }, c, out2);
+
+			for (auto i = 0uz; i < sds.size(); ++i)
+			{
+				EXPECT_EQ(shift_business_days(sds[i], days{ n }, c), out1[i]);
+				EXPECT_EQ(shift_business_days(sds[i], days{ n }, c), out2[i]);
+			}
+		}
+
+		// the failure is reported before anything is written
+		const auto& p = c.get_schedule().get_period();
+		sds.push_back(sys_days{ p.get_until() });
+		auto out = std::vector<sys_days>(sds.size());
+		EXPECT_THROW(shift_business_days(std::execution::par, sds, days{ 1 }, c, out), std::out_of_range);
+		EXPECT_EQ(sys_days{}, out.front());
+
+		sds.back() = sys_days{ p.get_from() };
+		EXPECT_THROW(shift_business_days(std::execution::par, sds, days{ -1 }, c, out), std::out_of_range);
+		EXPECT_EQ(sys_days{}, out.front());
+
+		EXPECT_THROW(shift_business_days(sds, days{ 1 }, c, std::span{ out }.first(1)), std::invalid_argument);
+	}
+
 }
@@ -0,0 +1,174 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <compressed_calendar.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <schedule.h>
+#include <calendar.h>
+#include <annual_holidays.h>
+#include <business_day_adjusters.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian::util;
+
+
+namespace gregorian
+{
+
+	static auto _make_rules_england() -> const annual_holiday_storage&
+	{
+		static const auto EarlyMayBankHoliday = weekday_indexed_holiday{ May / Monday[1] };
+		static const auto SpringBankHoliday = weekday_last_holiday{ May / Monday[last] };
+		static const auto SummerBankHoliday = weekday_last_holiday{ August / Monday[last] };
+
+		static const auto rules = annual_holiday_storage{
+			&NewYearsDay,
+			&GoodFriday,
+			&EasterMonday,
+			&EarlyMayBankHoliday,
+			&SpringBankHoliday,
+			&SummerBankHoliday,
+			&ChristmasDay,
+			&BoxingDay
+		};
+
+		return rules;
+	}
+
+	static void _expect_same(const compressed_calendar& cc, const calendar& c)
+	{
+		const auto& p = c.get_schedule().get_period();
+		ASSERT_EQ(p, cc.get_period());
+
+		const auto from = sys_days{ p.get_from() };
+		const auto until = sys_days{ p.get_until() };
+
+		for (auto d = from; d <= until; d += days{ 1 })
+			ASSERT_EQ(c.is_business_day(d), cc.is_business_day(d)) << year_month_day{ d };
+
+		// periods of different lengths (some longer than the cycle) starting at different points
+		for (auto f = from; f <= until; f += days{ 997 })
+			for (const auto length : { days{ 0 }, days{ 30 }, days{ 3652 }, days{ 150000 } })
+				if (f + length <= until)
+					EXPECT_EQ(c.count_business_days(period{ f, f + length }), cc.count_business_days(period{ f, f + length }));
+
+		EXPECT_EQ(c.count_business_days(p), cc.count_business_days(p));
+	}
+
+	TEST(compressed_calendar, constructor1)
+	{
+		const auto p = years_period{ 1600y, 2400y };
+		const auto& rules = _make_rules_england();
+
+		const auto cc = compressed_calendar{ SaturdaySundayWeekend, p, rules };
+		const auto c = calendar{ SaturdaySundayWeekend, make_holiday_schedule(p, rules) };
+
+		_expect_same(cc, c);
+
+		// only Easter based holidays (2 a year) should differ from the cycle
+		EXPECT_EQ(2uz * 801uz, cc.get_exceptions_size());
+	}
+
+	TEST(compressed_calendar, constructor2)
+	{
+		const auto p = years_period{ 1600y, 2400y };
+		const auto& rules = _make_rules_england();
+
+		const auto one_offs = schedule::dates{
+			2002y / June / 3d, // Golden Jubilee
+			2011y / April / 29d, // Royal Wedding
+			2022y / September / 19d, // State Funeral
+		};
+
+		const auto cc = compressed_calendar{ SaturdaySundayWeekend, p, rules, Following, one_offs };
+
+		auto generated = calendar{ SaturdaySundayWeekend, make_holiday_schedule(p, rules) };
+		generated.substitute(Following);
+		const auto c = calendar{ SaturdaySundayWeekend, generated.get_schedule() | schedule{ days_period{ p.get_from() / FirstDayOfJanuary, p.get_until() / LastDayOfDecember }, one_offs } };
+
+		_expect_same(cc, c);
+
+		EXPECT_FALSE(cc.is_business_day(2022y / September / 19d));
+		EXPECT_FALSE(cc.is_business_day(2022y / December / 27d)); // substituted Christmas
+	}
+
+	TEST(compressed_calendar, constructor3)
+	{
+		// shorter than the cycle
+		const auto p = years_period{ 2012y, 2112y };
+		const auto& rules = _make_rules_england();
+
+		const auto cc = compressed_calendar{ SaturdaySundayWeekend, p, rules, Following };
+
+		auto c = calendar{ SaturdaySundayWeekend, make_holiday_schedule(p, rules) };
+		c.substitute(Following);
+
+		_expect_same(cc, c);
+	}
+
+	TEST(compressed_calendar, constructor4)
+	{
+		const auto p = years_period{ 2012y, 2112y };
+		const auto& rules = _make_rules_england();
+
+		const auto one_offs = schedule::dates{ 2200y / January / 3d };
+
+		EXPECT_THROW(compressed_calendar(SaturdaySundayWeekend, p, rules, one_offs), out_of_range);
+	}
+
+	TEST(compressed_calendar, is_business_day1)
+	{
+		const auto cc = compressed_calendar{ SaturdaySundayWeekend, years_period{ 1600y, 2400y }, _make_rules_england() };
+
+		EXPECT_FALSE(cc.is_business_day(2023y / April / 7d)); // Good Friday
+		EXPECT_FALSE(cc.is_business_day(2023y / May / 1d));
+		EXPECT_TRUE(cc.is_business_day(2023y / May / 2d));
+		EXPECT_FALSE(cc.is_business_day(sys_days{ 2400y / December / 25d }));
+		EXPECT_THROW(static_cast<void>(cc.is_business_day(1599y / December / 31d)), out_of_range);
+		EXPECT_THROW(static_cast<void>(cc.is_business_day(sys_days{ 2401y / January / 1d })), out_of_range);
+		EXPECT_THROW(static_cast<void>(cc.count_business_days(days_period{ 1599y / December / 31d, 1600y / January / 31d })), out_of_range);
+	}
+
+	TEST(compressed_calendar, make_calendar1)
+	{
+		const auto& rules = _make_rules_england();
+		const auto cc = compressed_calendar{ SaturdaySundayWeekend, years_period{ 1600y, 2400y }, rules, Following };
+
+		const auto p = days_period{ 2020y / January / 1d, 2030y / December / 31d };
+		const auto c = cc.make_calendar(p);
+
+		EXPECT_EQ(p, c.get_schedule().get_period());
+		for (auto d = sys_days{ p.get_from() }; d <= sys_days{ p.get_until() }; d += days{ 1 })
+			EXPECT_EQ(cc.is_business_day(d), c.is_business_day(d));
+
+		EXPECT_THROW(static_cast<void>(cc.make_calendar(days_period{ 2400y / December / 1d, 2401y / January / 31d })), out_of_range);
+	}
+
+}
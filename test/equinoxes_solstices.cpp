@@ -183,4 +183,19 @@ namespace gregorian
 			EXPECT_EQ(y / December / d, DecemberSolstice.make_holiday(y));
 	}
 
+	TEST(anchor_tables, equinoxes_solstices)
+	{
+		static_assert(2024y / March / 20d == MarchEquinox.make_holiday(2024y));
+		static_assert(2024y / December / 21d == DecemberSolstice.make_holiday(2024y));
+
+		// tables are the same as the formulas (which are used outside of them)
+		for (auto y = _anchor_tables_from - years{ 10 }; y <= _anchor_tables_until + years{ 10 }; ++y)
+		{
+			EXPECT_EQ(_calculate_March_Equinox(y), MarchEquinox.make_holiday(y));
+			EXPECT_EQ(_calculate_June_Solstice(y), JuneSolstice.make_holiday(y));
+			EXPECT_EQ(_calculate_September_Equinox(y), SeptemberEquinox.make_holiday(y));
+			EXPECT_EQ(_calculate_December_Solstice(y), DecemberSolstice.make_holiday(y));
+		}
+	}
+
 }
@@ -30,6 +30,10 @@
 #include <chrono>
 #include <algorithm>
 #include <stdexcept>
+#include <array>
+#include <span>
+#include <vector>
+#include <memory>
 
 #include "setup.h"
 
@@ -139,6 +143,22 @@ namespace gregorian
 		EXPECT_EQ(expected, hols);
 	}
 
+	TEST(schedule, join1)
+	{
+		const auto s1 = make_holiday_schedule_united_states_may_2023();
+		const auto s2 = make_holiday_schedule_england_may_2023();
+		const auto s3 = make_mpc_dates_may_2023();
+		const auto s4 = make_holiday_schedule_england_april_2023();
+
+		const auto expected = s1 | s2 | s3;
+		EXPECT_EQ(expected, join(array{ &s1, &s2, &s3 }));
+		EXPECT_EQ(expected, join(array{ &s3, &s2, &s1, &s2 })); // in any order
+
+		EXPECT_EQ(s1, join(array{ &s1 }));
+		EXPECT_THROW(static_cast<void>(join(array{ &s1, &s4 })), out_of_range); // the same as |
+		EXPECT_THROW(static_cast<void>(join(span<const schedule* const>{})), invalid_argument);
+	}
+
 	TEST(schedule, operator_equal_to)
 	{
 		const auto& s1 = make_holiday_schedule_england_may_2023();
@@ -247,6 +267,71 @@ namespace gregorian
 		EXPECT_TRUE(s3.contains(sys_days{ 2023y / May / 1d }));
 	}
 
+	TEST(schedule, contains3)
+	{
+		// every day of a long schedule, also after it has been changed
+		auto s = make_holiday_schedule_england();
+		const auto& p = s.get_period();
+
+		s += 2019y / January / 2d;
+		s -= 2019y / January / 1d;
+
+		for (auto d = sys_days{ p.get_from() } - days{ 1 }; d <= sys_days{ p.get_until() } + days{ 1 }; d += days{ 1 })
+		{
+			const auto expected = ranges::binary_search(s.get_dates(), schedule::dates::value_type{ year_month_day{ d } });
+			EXPECT_EQ(expected, s.contains(d));
+			EXPECT_EQ(expected, s.contains(year_month_day{ d }));
+		}
+
+		EXPECT_TRUE(s.contains(2019y / January / 2d));
+		EXPECT_FALSE(s.contains(2019y / January / 1d));
+
+		// the same as the one made as a whole (with the index, if any)
+		const auto expected = make_schedule(p, vector<year_month_day>{ s.get_dates().cbegin(), s.get_dates().cend() });
+		EXPECT_EQ(expected, s);
+	}
+
+	TEST(schedule, serials)
+	{
+		const auto serial = [](const year_month_day& ymd) { return static_cast<int32_t>(sys_days{ ymd }.time_since_epoch().count()); };
+
+		// sorted and unique, the first and the last ones are outside of the period
+		auto serials = make_shared<vector<int32_t>>(vector<int32_t>{
+			serial(2022y / December / 26d),
+			serial(2023y / January / 2d),
+			serial(2023y / April / 7d),
+			serial(2023y / December / 25d),
+			serial(2024y / January / 1d)
+		});
+
+		const auto p = days_period{ 2023y / FirstDayOfJanuary, 2023y / LastDayOfDecember };
+		const auto s = schedule{ p, sorted_unique, span<const int32_t>{ *serials }, serials };
+		serials.reset(); // s keeps them alive
+
+		const auto expected = schedule{ p, { 2023y / January / 2d, 2023y / April / 7d, 2023y / December / 25d } };
+
+		for (auto d = sys_days{ 2022y / December / 1d }; d <= sys_days{ 2024y / January / 31d }; d += days{ 1 })
+		{
+			EXPECT_EQ(expected.contains(d), s.contains(d));
+			EXPECT_EQ(expected.contains(year_month_day{ d }), s.contains(year_month_day{ d }));
+		}
+
+		EXPECT_EQ(expected, s);
+		EXPECT_EQ(expected.get_dates(), s.get_dates());
+
+		// a change is made to a copy of the dates
+		auto copy = s;
+		copy += 2023y / May / 8d;
+		copy -= 2023y / April / 7d;
+		EXPECT_TRUE(copy.contains(2023y / May / 8d));
+		EXPECT_FALSE(copy.contains(2023y / April / 7d));
+		EXPECT_FALSE(s.contains(2023y / May / 8d));
+		EXPECT_TRUE(s.contains(2023y / April / 7d));
+		EXPECT_EQ(expected, s);
+
+		EXPECT_EQ(expected | copy, s | copy);
+	}
+
 
 	TEST(_make_period, multiple_years)
 	{
@@ -278,4 +363,34 @@ namespace gregorian
 		EXPECT_EQ(p.get_from(), p.get_until());
 	}
 
+
+	TEST(make_schedule, make_schedule1)
+	{
+		const auto p = days_period{ 2023y / FirstDayOfJanuary, 2023y / LastDayOfDecember };
+
+		// unsorted, duplicated, invalid and outside of the period
+		const auto s = make_schedule(
+			p,
+			vector<year_month_day>{
+				2023y / May / 8d,
+				2023y / January / 2d,
+				2023y / May / 8d,
+				2023y / February / 30d,
+				2024y / January / 1d,
+				2023y / April / 7d
+			}
+		);
+
+		const auto expected = schedule{
+			p,
+			{ 2023y / January / 2d, 2023y / April / 7d, 2023y / May / 8d }
+		};
+
+		EXPECT_EQ(expected, s);
+		EXPECT_TRUE(s.contains(2023y / April / 7d));
+		EXPECT_FALSE(s.contains(2024y / January / 1d));
+
+		EXPECT_EQ(schedule(p, {}), make_schedule(p, {}));
+	}
+
 }
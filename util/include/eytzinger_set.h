@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <concepts>
+#include <bit>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		// sorted keys in the order of a breadth first walk of a complete binary search tree (Eytzinger layout)
+		// the top levels of the tree share a few cache lines, so a search mostly misses only near the leaves,
+		// and contains is a loop without branches on the keys (it always runs for the depth of the tree)
+		template<std::integral Key>
+		class eytzinger_set final
+		{
+
+		public:
+
+			eytzinger_set() noexcept = default;
+
+			// keys have to be sorted and unique
+			explicit eytzinger_set(std::span<const Key> keys);
+
+		public:
+
+			[[nodiscard]] friend auto operator==(const eytzinger_set& s1, const eytzinger_set& s2) noexcept -> bool = default;
+
+		public:
+
+			[[nodiscard]] auto contains(const Key key) const noexcept -> bool;
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t;
+
+		private:
+
+			// in-order walk of the tree fills it with sorted keys
+			void _fill(std::span<const Key> keys, std::size_t& i, const std::size_t k);
+
+		private:
+
+			std::vector<Key> _keys; // 1 based (children of k are 2k and 2k + 1), so _keys[0] is not used
+
+		};
+
+
+
+		template<std::integral Key>
+		eytzinger_set<Key>::eytzinger_set(std::span<const Key> keys)
+		{
+			if (keys.empty())
+				return;
+
+			_keys.resize(keys.size() + 1uz);
+
+			auto i = 0uz;
+			_fill(keys, i, 1uz);
+		}
+
+
+		template<std::integral Key>
+		auto eytzinger_set<Key>::contains(const Key key) const noexcept -> bool
+		{
+			const auto n = size();
+
+			auto k = 1uz;
+			while (k <= n)
+				k = 2uz * k + static_cast<std::size_t>(_keys[k] < key);
+
+			// k went right after the last left turn towards the lower bound of the key (and then only right),
+			// so dropping those right turns (trailing ones) and the left turn gives the lower bound (or 0 if there is none)
+			k >>= std::countr_one(k) + 1;
+
+			return k != 0uz && _keys[k] == key;
+		}
+
+		template<std::integral Key>
+		auto eytzinger_set<Key>::size() const noexcept -> std::size_t
+		{
+			return _keys.empty() ? 0uz : _keys.size() - 1uz;
+		}
+
+
+		template<std::integral Key>
+		void eytzinger_set<Key>::_fill(std::span<const Key> keys, std::size_t& i, const std::size_t k)
+		{
+			if (k > keys.size())
+				return;
+
+			_fill(keys, i, 2uz * k);
+			_keys[k] = keys[i++];
+			_fill(keys, i, 2uz * k + 1uz);
+		}
+
+	}
+
+}
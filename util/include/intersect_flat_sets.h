@@ -24,9 +24,19 @@
 
 #include <flat_set>
 #include <vector>
+#include <span>
 #include <algorithm>
 #include <iterator>
 #include <utility>
+#include <concepts>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GREGORIAN_UTIL_INTERSECT_X86_64
+#include <emmintrin.h> // SSE2 is part of x86-64
+#endif
 
 
 namespace gregorian
@@ -35,15 +45,156 @@ namespace gregorian
 	namespace util
 	{
 
+		enum class intersect_kernel
+		{
+			linear, // set_intersection
+			galloping, // exponential search of each key of the smaller set in the larger one
+			simd // compares blocks of 4 keys with each other at once (SSE2), only for 32 bit integral keys
+		};
+
+
+		// picks the kernel by the ratio of the sizes (and the key)
 		template <typename Key>
-		[[nodiscard]] auto intersect_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b) -> std::flat_set<Key> // make it more generic?
+		[[nodiscard]] auto intersect_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b) -> std::flat_set<Key>; // make it more generic?
+
+		// the same, but with a given kernel (simd falls back to linear for keys it does not support)
+		template <typename Key>
+		[[nodiscard]] auto intersect_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b, const intersect_kernel k) -> std::flat_set<Key>;
+
+
+
+		// once the larger set is this many times larger, most of it is better skipped
+		constexpr auto _galloping_ratio = 8uz;
+
+		template <typename Key>
+		constexpr auto _is_simd_key = std::integral<Key> && sizeof(Key) == 4uz;
+
+
+		template <typename Key>
+		auto _as_span(const std::flat_set<Key>& s) noexcept -> std::span<const Key>
+		{
+			// flat_set keeps its keys in a vector (whatever its iterators are)
+			return s.empty() ? std::span<const Key>{} : std::span<const Key>{ &*s.begin(), s.size() };
+		}
+
+		template <typename Key>
+		void _intersect_linear(std::span<const Key> a, std::span<const Key> b, std::vector<Key>& result)
+		{
+			std::ranges::set_intersection(a, b, std::back_inserter(result));
+		}
+
+		template <typename Key>
+		void _intersect_galloping(std::span<const Key> small, std::span<const Key> large, std::vector<Key>& result)
+		{
+			auto from = 0uz;
+			for (const auto& key : small)
+			{
+				// double the step until we step over the key, then binary search the last step
+				auto step = 1uz;
+				while (from + step < large.size() && large[from + step] < key)
+					step *= 2uz;
+
+				const auto first = large.begin() + from + step / 2uz;
+				const auto last = large.begin() + std::min(from + step + 1uz, large.size());
+				const auto it = std::lower_bound(first, last, key);
+
+				from = static_cast<std::size_t>(it - large.begin());
+				if (from == large.size())
+					break;
+
+				if (!(key < *it))
+					result.push_back(key);
+			}
+		}
+
+#ifdef GREGORIAN_UTIL_INTERSECT_X86_64
+
+		// all 16 pairs of a block of a and a block of b are compared with 4 rotations of the block of b,
+		// then the block with the smaller last key moves on (both if they are the same)
+		template <typename Key>
+		void _intersect_simd(std::span<const Key> a, std::span<const Key> b, std::vector<Key>& result)
+		{
+			static_assert(_is_simd_key<Key>);
+
+			auto i = 0uz;
+			auto j = 0uz;
+			while (i + 4uz <= a.size() && j + 4uz <= b.size())
+			{
+				const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+				const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+
+				const auto eq = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+					_mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))))
+				);
+
+				// keys of a found in b (in order, as keys are unique each of them is found at most once)
+				auto found = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+				while (found != 0u)
+				{
+					result.push_back(a[i + static_cast<std::size_t>(std::countr_zero(found))]);
+					found &= found - 1u;
+				}
+
+				const auto a_last = a[i + 3uz];
+				const auto b_last = b[j + 3uz];
+				if (!(b_last < a_last))
+					i += 4uz;
+				if (!(a_last < b_last))
+					j += 4uz;
+			}
+
+			_intersect_linear(a.subspan(i), b.subspan(j), result);
+		}
+
+#endif
+
+
+		template <typename Key>
+		auto intersect_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b) -> std::flat_set<Key>
+		{
+			const auto small = std::min(a.size(), b.size());
+			const auto large = std::max(a.size(), b.size());
+
+			if (small != 0uz && large / small >= _galloping_ratio)
+				return intersect_flat_sets(a, b, intersect_kernel::galloping);
+			else if constexpr (_is_simd_key<Key>)
+				return intersect_flat_sets(a, b, intersect_kernel::simd);
+			else
+				return intersect_flat_sets(a, b, intersect_kernel::linear);
+		}
+
+		template <typename Key>
+		auto intersect_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b, const intersect_kernel k) -> std::flat_set<Key>
 		{
 			auto result = std::vector<Key>{};
 			// The intersection size will never exceed the size of the smaller set
 			result.reserve(std::min(a.size(), b.size()));
 
-			// Find overlapping elements in O(N + M) time
-			std::ranges::set_intersection(a, b, std::back_inserter(result));
+			const auto sa = _as_span(a);
+			const auto sb = _as_span(b);
+
+			switch (k)
+			{
+			case intersect_kernel::galloping:
+				if (sa.size() <= sb.size())
+					_intersect_galloping(sa, sb, result);
+				else
+					_intersect_galloping(sb, sa, result);
+				break;
+#ifdef GREGORIAN_UTIL_INTERSECT_X86_64
+			case intersect_kernel::simd:
+				if constexpr (_is_simd_key<Key>)
+				{
+					_intersect_simd(sa, sb, result);
+					break;
+				}
+				[[fallthrough]];
+#endif
+			default:
+				// Find overlapping elements in O(N + M) time
+				_intersect_linear(sa, sb, result);
+			}
 
 			// Construct flat_set without re-sorting or re-checking duplicates
 			return std::flat_set<Key>(std::sorted_unique, std::move(result));
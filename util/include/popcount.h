@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GREGORIAN_UTIL_POPCOUNT_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(GREGORIAN_UTIL_POPCOUNT_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define GREGORIAN_UTIL_POPCOUNT_TARGET(t) __attribute__((target(t)))
+#else
+#define GREGORIAN_UTIL_POPCOUNT_TARGET(t) // MSVC allows intrinsics without it
+#endif
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		// ordered from the least to the most demanding
+		enum class popcount_kernel
+		{
+			scalar,
+			avx2,
+			avx512
+		};
+
+
+		// number of set bits in all of the words
+		// (uses the most demanding kernel which the CPU supports - it is picked once, at the first call)
+		[[nodiscard]] auto popcount(std::span<const std::uint64_t> words) noexcept -> std::size_t;
+
+		// the same, but with a given kernel (it is up to the caller to make sure the CPU supports it)
+		[[nodiscard]] auto popcount(std::span<const std::uint64_t> words, const popcount_kernel k) noexcept -> std::size_t;
+
+		// kernel used by popcount(words) on this CPU
+		[[nodiscard]] auto get_popcount_kernel() noexcept -> popcount_kernel;
+
+
+
+		inline auto _popcount_scalar(std::span<const std::uint64_t> words) noexcept -> std::size_t
+		{
+			auto result = 0uz;
+			for (const auto word : words)
+				result += static_cast<std::size_t>(std::popcount(word));
+
+			return result;
+		}
+
+#ifdef GREGORIAN_UTIL_POPCOUNT_X86_64
+
+		// popcount of each byte via a nibble lookup table (vpshufb), then horizontal byte sums (vpsadbw)
+		GREGORIAN_UTIL_POPCOUNT_TARGET("avx2")
+		inline auto _popcount_avx2(std::span<const std::uint64_t> words) noexcept -> std::size_t
+		{
+			const auto lookup = _mm256_setr_epi8(
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+			);
+			const auto low_mask = _mm256_set1_epi8(0x0f);
+
+			auto sums = _mm256_setzero_si256();
+
+			auto i = 0uz;
+			for (; i + 4uz <= words.size(); i += 4uz)
+			{
+				const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words.data() + i));
+				const auto lo = _mm256_and_si256(v, low_mask);
+				const auto hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+				const auto bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+				sums = _mm256_add_epi64(sums, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+			}
+
+			alignas(32) std::uint64_t lanes[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+
+			const auto result = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+			return result + _popcount_scalar(words.subspan(i));
+		}
+
+		// vpopcntq on 8 words at a time, the tail is done with a masked load
+		GREGORIAN_UTIL_POPCOUNT_TARGET("avx512f,avx512vpopcntdq")
+		inline auto _popcount_avx512(std::span<const std::uint64_t> words) noexcept -> std::size_t
+		{
+			auto sums = _mm512_setzero_si512();
+
+			auto i = 0uz;
+			for (; i + 8uz <= words.size(); i += 8uz)
+				sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(_mm512_loadu_si512(words.data() + i)));
+
+			if (i != words.size())
+			{
+				const auto mask = static_cast<__mmask8>((1u << (words.size() - i)) - 1u);
+				sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, words.data() + i)));
+			}
+
+			return static_cast<std::size_t>(_mm512_reduce_add_epi64(sums));
+		}
+
+#endif
+
+		inline auto _detect_popcount_kernel() noexcept -> popcount_kernel
+		{
+#if defined(GREGORIAN_UTIL_POPCOUNT_X86_64) && (defined(__GNUC__) || defined(__clang__))
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+				return popcount_kernel::avx512;
+			if (__builtin_cpu_supports("avx2"))
+				return popcount_kernel::avx2;
+#elif defined(GREGORIAN_UTIL_POPCOUNT_X86_64)
+			int info[4];
+
+			__cpuid(info, 1);
+			const auto osxsave = (info[2] & (1 << 27)) != 0;
+			if (!osxsave)
+				return popcount_kernel::scalar;
+
+			const auto xcr0 = _xgetbv(0);
+			const auto ymm = (xcr0 & 0x06) == 0x06;
+			const auto zmm = (xcr0 & 0xe6) == 0xe6;
+
+			__cpuidex(info, 7, 0);
+			const auto avx2 = (info[1] & (1 << 5)) != 0;
+			const auto avx512f = (info[1] & (1 << 16)) != 0;
+			const auto avx512vpopcntdq = (info[2] & (1 << 14)) != 0;
+
+			if (zmm && avx512f && avx512vpopcntdq)
+				return popcount_kernel::avx512;
+			if (ymm && avx2)
+				return popcount_kernel::avx2;
+#endif
+			return popcount_kernel::scalar;
+		}
+
+
+		inline auto popcount(std::span<const std::uint64_t> words) noexcept -> std::size_t
+		{
+			// not worth the dispatch for a handful of words
+			if (words.size() < 8uz)
+				return _popcount_scalar(words);
+
+			static const auto k = get_popcount_kernel();
+			return popcount(words, k);
+		}
+
+		inline auto popcount(std::span<const std::uint64_t> words, const popcount_kernel k) noexcept -> std::size_t
+		{
+			switch (k)
+			{
+#ifdef GREGORIAN_UTIL_POPCOUNT_X86_64
+			case popcount_kernel::avx512:
+				return _popcount_avx512(words);
+			case popcount_kernel::avx2:
+				return _popcount_avx2(words);
+#endif
+			default:
+				return _popcount_scalar(words);
+			}
+		}
+
+		inline auto get_popcount_kernel() noexcept -> popcount_kernel
+		{
+			static const auto k = _detect_popcount_kernel();
+			return k;
+		}
+
+	}
+
+}
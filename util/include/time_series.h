@@ -23,13 +23,26 @@
 #pragma once
 
 #include <period.h>
+#include <popcount.h>
 
 #include <chrono>
 #include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 #include <utility>
+#include <optional>
+#include <expected>
+#include <system_error>
 #include <stdexcept>
 #include <compare>
-#include <bitset>
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
 
 
 namespace gregorian
@@ -38,7 +51,8 @@ namespace gregorian
 	namespace util
 	{
 
-		template<typename T>
+		// chunk_size is only used by time_series<bool> (see below)
+		template<typename T, std::size_t chunk_size = 64uz>
 		class time_series final
 		{
 
@@ -85,33 +99,160 @@ namespace gregorian
 
 
 
-		template<>
-		class time_series<bool>
+		// we store bools in 64 bit words (such that we can popcount them efficiently)
+		// and the words are grouped in chunks of chunk_size bits
+		// (64/128/256/512 to align with SSE/AVX - rank index has an entry per chunk
+		// and the storage is padded to a whole number of chunks)
+		//
+		// a lazy time series gets its observations from a generator, a block of words at a time,
+		// the first time the block is read or written (blocks cover about a year and are aligned to chunks)
+		// const member functions can be called from many threads at once:
+		// a block is populated by a single thread and is only read once it is published as ready
+		//
+		// words are kept in pages (of whole chunks) which copies share until one of them writes to a page (copy on write),
+		// so e.g. versions of a calendar which differ by a holiday or two only keep a copy of the pages which differ
+		// (a copy of a lazy time series only shares the pages all of whose blocks are populated)
+		// reads go through a flat table of page addresses, so a lookup is a single indirection
+		template<std::size_t chunk_size>
+		class time_series<bool, chunk_size>
 		{
 
+			static_assert(chunk_size != 0uz && chunk_size % 64uz == 0uz, "chunk_size should be a multiple of 64");
+			static_assert(chunk_size <= 4096uz, "chunk_size should fit in a page");
+
 		private:
 
-			static const auto _chunk_size = std::size_t{ 64u }; // maybe consider 128/256/512 to align with SSE/AVX
-			// we store bools in bitset chunks of this size (such that we can popcount them efficiently)
+			static constexpr auto _word_size = 64uz;
+			static constexpr auto _words_per_chunk = chunk_size / _word_size;
+
+			static constexpr auto _words_per_year = 6uz; // 384 days
+			static constexpr auto _words_per_block = (_words_per_year + _words_per_chunk - 1uz) / _words_per_chunk * _words_per_chunk;
+
+			// 4 KiB pages would hold 89 years, so they are smaller, to be shared by versions which differ somewhere in a century
+			static constexpr auto _words_per_page = 64uz; // 512 bytes, 4096 days (about 11 years)
 
 		public:
 
-			using _chunk = std::bitset<_chunk_size>;
+			// like std::bitset::reference
+			class reference final
+			{
+
+			public:
+
+				auto operator=(const bool value) noexcept -> reference&
+				{
+					if (value)
+						_word |= _mask;
+					else
+						_word &= ~_mask;
+
+					return *this;
+				}
+
+				auto operator=(const reference& r) noexcept -> reference&
+				{
+					return *this = static_cast<bool>(r);
+				}
 
-			using reference = _chunk::reference;
+				operator bool() const noexcept
+				{
+					return (_word & _mask) != std::uint64_t{ 0u };
+				}
+
+				auto operator~() const noexcept -> bool
+				{
+					return !static_cast<bool>(*this);
+				}
+
+				auto flip() noexcept -> reference&
+				{
+					_word ^= _mask;
+					return *this;
+				}
+
+			private:
+
+				friend class time_series;
+
+				reference(std::uint64_t& word, const std::uint64_t mask) noexcept :
+					_word{ word },
+					_mask{ mask }
+				{
+				}
+
+			private:
+
+				std::uint64_t& _word;
+				std::uint64_t _mask;
+
+			};
 
 		public:
 
+			// should not throw (it is called from const, noexcept member functions)
+			using generator = std::function<bool(const std::chrono::sys_days&)>;
+
 			explicit time_series(const util::days_period& period) noexcept;
 
+			// lazy (nothing is generated until it is needed)
+			time_series(const util::days_period& period, generator g);
+
+			// from prebuilt words (e.g. mapped from a file), the first observation is the lowest bit of the first word
+			// (there should be exactly as many words as it takes to hold the period, bits past its end are ignored)
+			time_series(const util::days_period& period, std::span<const std::uint64_t> words);
+
+			// the same, but refers to the words rather than copies them (e.g. to the pages of a mapped file)
+			// owner keeps them alive and they are never written to (a page is copied the first time it is written to)
+			// (bits past the end of the period have to be clear, a last page which is not whole is copied)
+			time_series(const util::days_period& period, std::span<const std::uint64_t> words, std::shared_ptr<const void> owner);
+
+			// the same, but refers to whole pages (of get_page_words() words each) rather than to consecutive words,
+			// so time series which refer to the same page share it (e.g. versions of a calendar in a calendar database)
+			// (there should be exactly as many pages as it takes to hold the period and bits past its end have to be clear)
+			time_series(const util::days_period& period, std::span<const std::uint64_t* const> pages, std::shared_ptr<const void> owner);
+
 		private:
 
 			explicit time_series(const util::period<std::chrono::sys_days> period) noexcept;
 
 		public:
 
-			[[nodiscard]] friend auto operator==(const time_series& ts1, const time_series& ts2) noexcept -> bool = default;
+			// blocks which are being populated by another thread at the time of copy are left for the copy to populate again
+			time_series(const time_series& ts);
+			time_series(time_series&& ts) noexcept;
+
+			auto operator=(const time_series& ts) -> time_series&;
+			auto operator=(time_series&& ts) noexcept -> time_series&;
+
+			~time_series() noexcept = default;
+
+		public:
+
+			// rank index and laziness are not part of the value
+#ifdef _MSC_BUILD 
+			[[nodiscard]] friend auto operator==(const time_series& ts1, const time_series& ts2) noexcept -> bool
+#else
+			friend auto operator==(const time_series& ts1, const time_series& ts2) noexcept -> bool
+#endif
+			{
+				ts1.populate();
+				ts2.populate();
+
+				if (ts1._period != ts2._period)
+					return false;
+
+				for (auto p = 0uz; p < ts1._pages.size(); ++p)
+					if (!ts1._same_page(p, ts2))
+						return false;
+
+				return true;
+			}
+
+#ifdef _MSC_BUILD 
 			[[nodiscard]] friend auto operator<=>(const time_series& ts1, const time_series& ts2) noexcept -> std::strong_ordering = delete;
+#else
+			friend auto operator<=>(const time_series& ts1, const time_series& ts2) noexcept -> std::strong_ordering = delete;
+#endif
 
 		public:
 
@@ -121,85 +262,242 @@ namespace gregorian
 			[[nodiscard]] auto operator[](const std::chrono::sys_days& sd) -> reference;
 			[[nodiscard]] auto operator[](const std::chrono::sys_days& sd) const -> bool;
 
+			// the same as const operator[], but sd has to be within the period (only asserted in debug builds)
+			// for callers which have already checked their range (so it is just a shift and a bit test)
+			[[nodiscard]] auto get_unchecked(const std::chrono::sys_days& sd) const noexcept -> bool;
+
+			// the same as const operator[], but returns std::errc::argument_out_of_domain rather than throws
+			[[nodiscard]] auto try_get(const std::chrono::sys_days& sd) const noexcept -> std::expected<bool, std::errc>;
+
 		public:
 
 			[[nodiscard]] auto get_period() const noexcept -> util::days_period;
 
 		public:
 
+			// a lazy time series stops being lazy once it is fully populated and copied, written to or indexed
+			// (before that a fully populated one only looks at a single counter rather than at its blocks)
+			[[nodiscard]] auto is_lazy() const noexcept -> bool;
+
+			// whether all the blocks have been populated (always true if not lazy)
+			[[nodiscard]] auto is_populated() const noexcept -> bool;
+
+			// populates all the blocks which have not been populated yet
+			void populate() const noexcept;
+
+		public:
+
+			// the words with from and until get a single masked popcount each
+			// and the words in between go to util::popcount (AVX-512/AVX2 where the CPU has them)
 			[[nodiscard]] auto count(const util::days_period& p) const -> std::size_t;
 			[[nodiscard]] auto count(const util::period<std::chrono::sys_days>& p) const -> std::size_t;
 
+		public:
+
+			// rank index is a cumulative count of true observations before each chunk,
+			// so count becomes 2 lookups and 2 masked popcounts (independent of the length of the period)
+			// it is not maintained by the non-const operator[] (any write drops it), so it should be (re)built
+			// once all the observations are set
+			// (a lazy time series builds it by itself when its last block gets populated,
+			// calling this function populates all the blocks)
+			void build_rank_index();
+
+			[[nodiscard]] auto has_rank_index() const noexcept -> bool;
+
+			// rank is the number of observations equal to value before sd
+			// and select is its inverse - the day of the observation equal to value with a given rank
+			// (both work without the rank index, but then they go a block at a time from the start of the period,
+			// only populate the blocks up to the one they need and keep the counts of the blocks they have been through)
+			[[nodiscard]] auto rank(const std::chrono::sys_days& sd, const bool value) const -> std::size_t;
+			[[nodiscard]] auto select(const std::size_t r, const bool value) const -> std::chrono::sys_days;
+
+		public:
+
+			// first observation equal to value on or after sd / last one on or before sd (if any)
+			// scans whole words (with countr_zero/countl_zero) rather than individual days
+			[[nodiscard]] auto find_next(const std::chrono::sys_days& sd, const bool value) const -> std::optional<std::chrono::sys_days>;
+			[[nodiscard]] auto find_previous(const std::chrono::sys_days& sd, const bool value) const -> std::optional<std::chrono::sys_days>;
+
+			// both of the above in a single scan outwards from sd (so the nearer one is usually found in the very first word)
+			[[nodiscard]] auto find_around(const std::chrono::sys_days& sd, const bool value) const
+				-> std::pair<std::optional<std::chrono::sys_days>, std::optional<std::chrono::sys_days>>;
+
+		public:
+
+			// word by word or/and with the observations of ts over the period of this time series
+			// (ts has to cover it, but does not have to start on the same day)
+			auto operator|=(const time_series& ts) -> time_series&;
+			auto operator&=(const time_series& ts) -> time_series&;
+
+		public:
+
+			// pages with the same observations as the pages of ts for the same days become shared with ts
+			// (both are populated first, pages are only compared if both time series start on the same day)
+			// returns the number of pages shared with ts (including the ones which have been shared already)
+			auto share_pages(const time_series& ts) -> std::size_t;
+
+			// number of pages which are already shared with ts (nothing is compared or populated)
+			[[nodiscard]] auto count_shared_pages(const time_series& ts) const noexcept -> std::size_t;
+
+			// days of the period common to both time series on which their observations differ (in order)
+			// (both are populated first, if they start on the same day pages shared with ts are skipped
+			// and the rest are compared a word at a time, otherwise a day at a time)
+			[[nodiscard]] auto find_differences(const time_series& ts) const -> std::vector<std::chrono::sys_days>;
+
 		public:
 
 			// to help with testing
 			[[nodiscard]] static auto get_chunk_size() noexcept -> std::size_t;
 
+			[[nodiscard]] static auto get_page_size() noexcept -> std::size_t; // in days
+
+			[[nodiscard]] static auto get_page_words() noexcept -> std::size_t;
+
 		private:
 
-			auto _index_outer(const std::chrono::sys_days& sd) const -> std::size_t;
-			auto _index_inner(const std::chrono::sys_days& sd) const -> std::size_t;
+			// the only place where a day is checked against the period
+			auto _offset(const std::chrono::sys_days& sd) const -> std::size_t;
+
+			auto _contains(const std::chrono::sys_days& sd) const noexcept -> bool;
+
+			auto _bit(const std::size_t offset) const noexcept -> bool;
+
+			auto _size() const noexcept -> std::size_t;
+
+			// word with the given index where set bits are observations equal to value
+			// (with !value padding at the end of the last chunk is set)
+			auto _word(const std::size_t word_index, const bool value) const noexcept -> std::uint64_t;
+
+			// number of true observations in [from, from + offset) - requires the rank index
+			auto _rank(const std::size_t offset) const noexcept -> std::size_t;
+
+			// number of observations equal to value in the chunks before the chunk with a given index
+			auto _chunks_rank(const std::size_t chunk_index, const bool value) const noexcept -> std::size_t;
+
+			// number of true observations in the blocks before the block with a given index
+			// (populates them and extends the partial rank index up to it)
+			auto _blocks_rank(const std::size_t block_index) const noexcept -> std::size_t;
+
+			auto _block_count() const noexcept -> std::size_t;
+
+			// makes sure the blocks with words [first_word_index, last_word_index] are populated (if lazy)
+			void _populate(const std::size_t first_word_index, const std::size_t last_word_index) const noexcept;
+
+			void _populate_block(const std::size_t block_index) const noexcept;
+
+			// drops the blocks and the generator once all the blocks are populated (so reads take the plain path)
+			void _release_blocks() noexcept;
+
+			void _publish_rank_index() const;
+
+			// 64 observations starting with the one at offset (zeros past the end of the storage)
+			auto _bits(const std::size_t offset) const noexcept -> std::uint64_t;
+
+			// word with a given index (as it is stored, it is up to the caller to populate it first)
+			auto _get(const std::size_t word_index) const noexcept -> std::uint64_t;
+
+			// the same, but to write to (the page with it is copied first if it is shared)
+			auto _set(const std::size_t word_index) -> std::uint64_t&;
+
+			// number of true observations in count words from the one with a given index (across pages)
+			auto _popcount(std::size_t first_word_index, std::size_t count) const noexcept -> std::size_t;
+
+			void _unshare(const std::size_t page_index);
+
+			// whether the page with a given index has the same words as the one of ts (for the same word indices)
+			auto _same_page(const std::size_t page_index, const time_series& ts) const noexcept -> bool;
+
+			template<typename BinaryOperation>
+			void _combine(const time_series& ts, BinaryOperation op);
 
 		private:
 
 			util::period<std::chrono::sys_days> _period;
 
-			using _storage = std::vector<_chunk>;
+			struct _page final
+			{
+				std::array<std::uint64_t, _words_per_page> words{};
+			};
+
+			// pages are only written to through const member functions when they are populated (so are never shared then)
+			std::vector<const std::uint64_t*> _pages; // _words_per_page words each (to read from)
+			std::vector<std::shared_ptr<_page>> _owners; // the same pages (to write to and to share), empty if not owned
+			std::shared_ptr<const void> _external; // keeps the pages which are not owned alive
+			std::size_t _words{ 0uz }; // number of words in use (whole chunks), the rest of the last page is not (and is all zeros)
+
+			using _rank_storage = std::vector<std::size_t>;
 
-			_storage _observations;
+			mutable _rank_storage _ranks; // either empty or number of chunks + 1 long
+			mutable std::atomic<bool> _ranked{ false }; // _ranks can be read (with acquire) once this is set
+
+			// partial rank index (for rank and select without the one above), one more than the number of blocks
+			mutable std::vector<std::atomic<std::size_t>> _block_ranks; // number of true observations before each block
+			mutable std::atomic<std::size_t> _ranked_blocks{ 0uz }; // _block_ranks are known up to this one (with acquire)
+
+			// laziness
+			enum _block_state : std::uint8_t
+			{
+				_unpopulated,
+				_populating,
+				_populated
+			};
+
+			generator _generator; // empty if not lazy
+			mutable std::vector<std::atomic<std::uint8_t>> _blocks; // empty if not lazy
+			mutable std::atomic<std::size_t> _populated_blocks{ 0uz };
 
 		};
 
 
 
-		template<typename T>
-		time_series<T>::time_series(const util::days_period& period) noexcept :
+		template<typename T, std::size_t chunk_size>
+		time_series<T, chunk_size>::time_series(const util::days_period& period) noexcept :
 			time_series{ util::period<std::chrono::sys_days>{ period.get_from(), period.get_until() } }
 		{
 		}
 
-		template<typename T>
-		time_series<T>::time_series(const util::period<std::chrono::sys_days> period) noexcept :
+		template<typename T, std::size_t chunk_size>
+		time_series<T, chunk_size>::time_series(const util::period<std::chrono::sys_days> period) noexcept :
 			_period{ std::move(period) },
 			_observations(_index(_period.get_until()) + std::size_t{ 1u })
 		{
 		}
 
 
-		template<typename T>
-		auto time_series<T>::operator[](const std::chrono::year_month_day& ymd) -> T&
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::operator[](const std::chrono::year_month_day& ymd) -> T&
 		{
 			return _observations[_index(ymd)];
 		}
 
-		template<typename T>
-		auto time_series<T>::operator[](const std::chrono::year_month_day& ymd) const -> const T&
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::operator[](const std::chrono::year_month_day& ymd) const -> const T&
 		{
 			return _observations[_index(ymd)];
 		}
 
-		template<typename T>
-		auto time_series<T>::operator[](const std::chrono::sys_days& sd) -> T&
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::operator[](const std::chrono::sys_days& sd) -> T&
 		{
 			return _observations[_index(sd)];
 		}
 
-		template<typename T>
-		auto time_series<T>::operator[](const std::chrono::sys_days& sd) const -> const T&
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::operator[](const std::chrono::sys_days& sd) const -> const T&
 		{
 			return _observations[_index(sd)];
 		}
 
 
-		template<typename T>
-		auto time_series<T>::get_period() const noexcept -> util::days_period
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::get_period() const noexcept -> util::days_period
 		{
 			return util::days_period{ _period.get_from(), _period.get_until() };
 		}
 
 
-		template<typename T>
-		auto time_series<T>::_index(const std::chrono::sys_days& sd) const -> std::size_t
+		template<typename T, std::size_t chunk_size>
+		auto time_series<T, chunk_size>::_index(const std::chrono::sys_days& sd) const -> std::size_t
 		{
 			if (sd < _period.get_from() || sd > _period.get_until())
 				throw std::out_of_range{ "Request is not consistent with from/until" };
@@ -210,70 +508,852 @@ namespace gregorian
 
 
 
-		inline time_series<bool>::time_series(const util::days_period& period) noexcept :
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::days_period& period) noexcept :
 			time_series{ util::period<std::chrono::sys_days>{ period.get_from(), period.get_until() } }
 		{
 		}
 
-		inline time_series<bool>::time_series(const util::period<std::chrono::sys_days> period) noexcept :
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::period<std::chrono::sys_days> period) noexcept :
 			_period{ std::move(period) },
-			_observations(_index_outer(_period.get_until()) + std::size_t{ 1u })
+			_words{ (_size() / chunk_size + std::size_t{ 1u }) * _words_per_chunk }
 		{
+			const auto pages = (_words + _words_per_page - 1uz) / _words_per_page;
+			_pages.reserve(pages);
+			_owners.reserve(pages);
+			for (auto p = 0uz; p < pages; ++p)
+			{
+				_owners.push_back(std::make_shared<_page>());
+				_pages.push_back(_owners.back()->words.data());
+			}
+
+			_block_ranks = std::vector<std::atomic<std::size_t>>(_block_count() + 1uz);
 		}
 
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::days_period& period, generator g) :
+			time_series{ period }
+		{
+			if (g)
+			{
+				_generator = std::move(g);
+				_blocks = std::vector<std::atomic<std::uint8_t>>(_block_count());
+			}
+		}
 
-		inline auto time_series<bool>::operator[](const std::chrono::year_month_day& ymd) -> reference
+
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::days_period& period, std::span<const std::uint64_t> words) :
+			time_series{ period }
 		{
-			return _observations[_index_outer(ymd)][_index_inner(ymd)];
+			const auto size = _size();
+			if (words.size() != (size + _word_size - 1uz) / _word_size)
+				throw std::invalid_argument{ "Number of words should match the period" };
+
+			for (auto j = 0uz; j < words.size(); ++j)
+				_set(j) = words[j];
+
+			if (const auto tail = size % _word_size; tail != 0uz)
+				_set(words.size() - 1uz) &= (std::uint64_t{ 1u } << tail) - std::uint64_t{ 1u };
 		}
 
-		inline auto time_series<bool>::operator[](const std::chrono::year_month_day& ymd) const -> bool
+
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::days_period& period, std::span<const std::uint64_t> words, std::shared_ptr<const void> owner) :
+			_period{ period.get_from(), period.get_until() },
+			_external{ std::move(owner) },
+			_words{ (_size() / chunk_size + std::size_t{ 1u }) * _words_per_chunk }
 		{
-			return _observations[_index_outer(ymd)][_index_inner(ymd)];
+			const auto size = _size();
+			if (words.size() != (size + _word_size - 1uz) / _word_size)
+				throw std::invalid_argument{ "Number of words should match the period" };
+
+			if (const auto tail = size % _word_size; tail != 0uz && (words.back() >> tail) != std::uint64_t{ 0u })
+				throw std::invalid_argument{ "Bits past the end of the period should be clear" };
+
+			const auto pages = (_words + _words_per_page - 1uz) / _words_per_page;
+			_pages.reserve(pages);
+			_owners.reserve(pages);
+			for (auto p = 0uz; p < pages; ++p)
+			{
+				const auto first = p * _words_per_page;
+				if (first + _words_per_page <= words.size())
+				{
+					_owners.emplace_back();
+					_pages.push_back(words.data() + first);
+				}
+				else
+				{
+					_owners.push_back(std::make_shared<_page>());
+					if (first < words.size())
+						std::copy(words.begin() + first, words.end(), _owners.back()->words.begin());
+					_pages.push_back(_owners.back()->words.data());
+				}
+			}
+
+			_block_ranks = std::vector<std::atomic<std::size_t>>(_block_count() + 1uz);
 		}
 
-		inline auto time_series<bool>::operator[](const std::chrono::sys_days& sd) -> reference
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const util::days_period& period, std::span<const std::uint64_t* const> pages, std::shared_ptr<const void> owner) :
+			_period{ period.get_from(), period.get_until() },
+			_external{ std::move(owner) },
+			_words{ (_size() / chunk_size + std::size_t{ 1u }) * _words_per_chunk }
 		{
-			return _observations[_index_outer(sd)][_index_inner(sd)];
+			const auto size = _size();
+			const auto words = (size + _word_size - 1uz) / _word_size;
+			if (pages.size() != (words + _words_per_page - 1uz) / _words_per_page)
+				throw std::invalid_argument{ "Number of pages should match the period" };
+
+			// the rest of the last page is not in use, so it has to be all zeros
+			const auto* const last = pages.back();
+			const auto last_word = (words - 1uz) % _words_per_page;
+			if (
+				const auto tail = size % _word_size;
+				(tail != 0uz && (last[last_word] >> tail) != std::uint64_t{ 0u }) ||
+				std::any_of(last + last_word + 1uz, last + _words_per_page, [](const std::uint64_t word) { return word != std::uint64_t{ 0u }; })
+			)
+				throw std::invalid_argument{ "Bits past the end of the period should be clear" };
+
+			// a page of padding (if the period ends on a chunk boundary) is not referred to
+			const auto all_pages = (_words + _words_per_page - 1uz) / _words_per_page;
+			_pages.reserve(all_pages);
+			_owners.reserve(all_pages);
+			for (auto p = 0uz; p < all_pages; ++p)
+			{
+				if (p < pages.size())
+				{
+					_owners.emplace_back();
+					_pages.push_back(pages[p]);
+				}
+				else
+				{
+					_owners.push_back(std::make_shared<_page>());
+					_pages.push_back(_owners.back()->words.data());
+				}
+			}
+
+			_block_ranks = std::vector<std::atomic<std::size_t>>(_block_count() + 1uz);
 		}
 
-		inline auto time_series<bool>::operator[](const std::chrono::sys_days& sd) const -> bool
+
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(const time_series& ts) :
+			_period{ ts._period },
+			_external{ ts._external },
+			_words{ ts._words }
 		{
-			return _observations[_index_outer(sd)][_index_inner(sd)];
+			if (ts.is_populated()) // or not lazy, either way the copy is not lazy
+			{
+				_pages = ts._pages; // shared
+				_owners = ts._owners;
+			}
+			else
+			{
+				_generator = ts._generator;
+				_blocks = std::vector<std::atomic<std::uint8_t>>(ts._blocks.size());
+
+				// which blocks are populated is only read once (another thread could be populating the rest)
+				auto populated = std::vector<bool>(ts._blocks.size());
+				for (auto b = 0uz; b < ts._blocks.size(); ++b)
+					populated[b] = ts._blocks[b].load(std::memory_order_acquire) == _populated;
+
+				// pages all of whose blocks are populated are shared, the rest are new
+				_pages.reserve(ts._pages.size());
+				_owners.reserve(ts._owners.size());
+				for (auto p = 0uz; p < ts._pages.size(); ++p)
+				{
+					const auto first = p * _words_per_page / _words_per_block;
+					const auto last = (std::min((p + 1uz) * _words_per_page, _words) - 1uz) / _words_per_block;
+					if (std::all_of(populated.begin() + first, populated.begin() + last + 1uz, std::identity{}))
+						_owners.push_back(ts._owners[p]);
+					else
+						_owners.push_back(std::make_shared<_page>());
+					_pages.push_back(_owners.back()->words.data());
+				}
+
+				// and the populated blocks are copied to the new pages
+				auto populated_blocks = 0uz;
+				for (auto b = 0uz; b < ts._blocks.size(); ++b)
+				{
+					if (!populated[b])
+						continue;
+
+					const auto first = b * _words_per_block;
+					const auto last = std::min(first + _words_per_block, _words);
+					for (auto j = first; j < last; ++j)
+						if (_pages[j / _words_per_page] != ts._pages[j / _words_per_page])
+							_owners[j / _words_per_page]->words[j % _words_per_page] = ts._get(j);
+
+					_blocks[b].store(_populated, std::memory_order_relaxed);
+					++populated_blocks;
+				}
+				_populated_blocks.store(populated_blocks, std::memory_order_relaxed);
+			}
+
+			if (ts.has_rank_index())
+			{
+				_ranks = ts._ranks;
+				_ranked.store(true, std::memory_order_relaxed);
+			}
+
+			const auto ranked_blocks = ts._ranked_blocks.load(std::memory_order_acquire);
+			_block_ranks = std::vector<std::atomic<std::size_t>>(ts._block_ranks.size());
+			for (auto b = 1uz; b <= ranked_blocks; ++b)
+				_block_ranks[b].store(ts._block_ranks[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			_ranked_blocks.store(ranked_blocks, std::memory_order_relaxed);
 		}
 
+		template<std::size_t chunk_size>
+		time_series<bool, chunk_size>::time_series(time_series&& ts) noexcept :
+			_period{ std::move(ts._period) },
+			_pages{ std::move(ts._pages) },
+			_owners{ std::move(ts._owners) },
+			_external{ std::move(ts._external) },
+			_words{ std::exchange(ts._words, 0uz) },
+			_ranks{ std::move(ts._ranks) },
+			_ranked{ ts._ranked.exchange(false, std::memory_order_relaxed) },
+			_block_ranks{ std::move(ts._block_ranks) },
+			_ranked_blocks{ ts._ranked_blocks.exchange(0uz, std::memory_order_relaxed) },
+			_generator{ std::move(ts._generator) },
+			_blocks{ std::move(ts._blocks) },
+			_populated_blocks{ ts._populated_blocks.exchange(0uz, std::memory_order_relaxed) }
+		{
+		}
 
-		inline auto time_series<bool>::get_period() const noexcept -> util::days_period
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator=(const time_series& ts) -> time_series&
+		{
+			if (this != &ts)
+				*this = time_series{ ts };
+
+			return *this;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator=(time_series&& ts) noexcept -> time_series&
+		{
+			_period = std::move(ts._period);
+			_pages = std::move(ts._pages);
+			_owners = std::move(ts._owners);
+			_external = std::move(ts._external);
+			_words = std::exchange(ts._words, 0uz);
+			_ranks = std::move(ts._ranks);
+			_ranked.store(ts._ranked.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+			_block_ranks = std::move(ts._block_ranks);
+			_ranked_blocks.store(ts._ranked_blocks.exchange(0uz, std::memory_order_relaxed), std::memory_order_relaxed);
+			_generator = std::move(ts._generator);
+			_blocks = std::move(ts._blocks);
+			_populated_blocks.store(ts._populated_blocks.exchange(0uz, std::memory_order_relaxed), std::memory_order_relaxed);
+
+			return *this;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator[](const std::chrono::year_month_day& ymd) -> reference
+		{
+			return (*this)[std::chrono::sys_days{ ymd }];
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator[](const std::chrono::year_month_day& ymd) const -> bool
+		{
+			return (*this)[std::chrono::sys_days{ ymd }];
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator[](const std::chrono::sys_days& sd) -> reference
+		{
+			const auto offset = _offset(sd);
+			_populate(offset / _word_size, offset / _word_size); // so the generator does not overwrite it later
+			_release_blocks();
+
+			_ranked.store(false, std::memory_order_relaxed);
+			_ranks.clear();
+			_ranked_blocks.store(std::min(_ranked_blocks.load(std::memory_order_relaxed), offset / _word_size / _words_per_block), std::memory_order_relaxed);
+			return reference{ _set(offset / _word_size), std::uint64_t{ 1u } << (offset % _word_size) };
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator[](const std::chrono::sys_days& sd) const -> bool
+		{
+			return _bit(_offset(sd));
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::get_unchecked(const std::chrono::sys_days& sd) const noexcept -> bool
+		{
+			assert(_contains(sd));
+			return _bit(static_cast<std::size_t>((sd - _period.get_from()).count()));
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::try_get(const std::chrono::sys_days& sd) const noexcept -> std::expected<bool, std::errc>
+		{
+			if (!_contains(sd))
+				return std::unexpected{ std::errc::argument_out_of_domain };
+
+			return _bit(static_cast<std::size_t>((sd - _period.get_from()).count()));
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::get_period() const noexcept -> util::days_period
 		{
 			return util::days_period{ _period.get_from(), _period.get_until() };
 		}
 
 
-		inline auto time_series<bool>::get_chunk_size() noexcept -> std::size_t
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::is_lazy() const noexcept -> bool
+		{
+			return !_blocks.empty();
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::is_populated() const noexcept -> bool
+		{
+			return _populated_blocks.load(std::memory_order_acquire) == _blocks.size();
+		}
+
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::populate() const noexcept
 		{
-			return _chunk_size;
+			_populate(0uz, _words - 1uz);
 		}
 
 
-		inline auto time_series<bool>::_index_outer(const std::chrono::sys_days& sd) const -> std::size_t
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::build_rank_index()
 		{
-			if (sd < _period.get_from() || sd > _period.get_until())
-				throw std::out_of_range{ "Request is not consistent with from/until" };
+			populate(); // which could have built it already
+			_release_blocks();
 
-			const auto days = sd - _period.get_from();
-			return days.count() / _chunk_size;
+			if (!has_rank_index())
+				_publish_rank_index();
 		}
 
-		inline auto time_series<bool>::_index_inner(const std::chrono::sys_days& sd) const -> std::size_t
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::_publish_rank_index() const
 		{
-			if (sd < _period.get_from() || sd > _period.get_until())
+			const auto chunks = _words / _words_per_chunk;
+
+			auto ranks = _rank_storage{};
+			ranks.reserve(chunks + 1uz);
+
+			auto rank = 0uz;
+			ranks.push_back(rank);
+			for (auto j = 0uz; j < chunks; ++j)
+			{
+				rank += _popcount(j * _words_per_chunk, _words_per_chunk);
+				ranks.push_back(rank);
+			}
+
+			_ranks = std::move(ranks);
+			_ranked.store(true, std::memory_order_release);
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::has_rank_index() const noexcept -> bool
+		{
+			return _ranked.load(std::memory_order_acquire);
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::rank(const std::chrono::sys_days& sd, const bool value) const -> std::size_t
+		{
+			const auto offset = _offset(sd);
+
+			auto trues = 0uz;
+			if (has_rank_index())
+				trues = _rank(offset);
+			else
+			{
+				// the blocks before the one with sd, then the words of that block before sd
+				const auto word_index = offset / _word_size;
+				const auto first = word_index / _words_per_block * _words_per_block;
+				trues = _blocks_rank(word_index / _words_per_block);
+
+				_populate(first, word_index);
+				trues += _popcount(first, word_index - first);
+				if (const auto inner = offset % _word_size; inner != 0uz)
+					trues += static_cast<std::size_t>(std::popcount(_get(word_index) & ((std::uint64_t{ 1u } << inner) - std::uint64_t{ 1u })));
+			}
+
+			return value ? trues : offset - trues;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::select(const std::size_t r, const bool value) const -> std::chrono::sys_days
+		{
+			const auto size = _size();
+
+			// find the word which contains the observation
+			// (with the rank index start from the last chunk with less than r + 1 observations before it,
+			// otherwise from the first block with more than r observations up to its end)
+			auto word_index = 0uz;
+			auto before = 0uz;
+			if (has_rank_index())
+			{
+				const auto trues = _ranks.back();
+				const auto total = value ? trues : size - trues;
+				if (r >= total)
+					throw std::out_of_range{ "Request is not consistent with from/until" };
+
+				auto lo = 0uz;
+				auto hi = _ranks.size() - 1uz; // _chunks_rank(hi, value) > r is guaranteed
+				while (hi - lo > 1uz)
+				{
+					const auto mid = lo + (hi - lo) / 2uz;
+					if (_chunks_rank(mid, value) <= r)
+						lo = mid;
+					else
+						hi = mid;
+				}
+
+				word_index = lo * _words_per_chunk;
+				before = _chunks_rank(lo, value);
+			}
+			else
+			{
+				const auto block_size = _words_per_block * _word_size; // in days
+				auto b = 0uz;
+				for (;; ++b)
+				{
+					if (b == _block_count())
+						throw std::out_of_range{ "Request is not consistent with from/until" };
+
+					const auto trues = _blocks_rank(b + 1uz);
+					if ((value ? trues : std::min((b + 1uz) * block_size, size) - trues) > r)
+						break;
+				}
+
+				const auto trues = _blocks_rank(b);
+				word_index = b * _words_per_block;
+				before = value ? trues : b * block_size - trues;
+			}
+
+			for (;; ++word_index)
+			{
+				const auto in_word = static_cast<std::size_t>(std::popcount(_word(word_index, value)));
+				if (before + in_word > r)
+					break;
+				before += in_word;
+			}
+
+			// then find the observation within the word
+			// (padding at the end of the last chunk is never reached as r < total)
+			auto word = _word(word_index, value);
+			for (auto i = before; i < r; ++i)
+				word &= word - std::uint64_t{ 1u }; // drop the lowest set bit // could use pdep where BMI2 is available
+
+			const auto offset = word_index * _word_size + static_cast<std::size_t>(std::countr_zero(word));
+
+			return _period.get_from() + std::chrono::days{ offset };
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::find_next(const std::chrono::sys_days& sd, const bool value) const -> std::optional<std::chrono::sys_days>
+		{
+			const auto offset = _offset(sd);
+			const auto size = _size();
+
+			auto word_index = offset / _word_size;
+			auto word = _word(word_index, value) & (~std::uint64_t{ 0u } << (offset % _word_size));
+			for (;;)
+			{
+				if (word != std::uint64_t{ 0u })
+				{
+					const auto found = word_index * _word_size + static_cast<std::size_t>(std::countr_zero(word));
+					if (found >= size) // padding
+						return std::nullopt;
+
+					return _period.get_from() + std::chrono::days{ found };
+				}
+
+				if (++word_index == _words)
+					return std::nullopt;
+
+				word = _word(word_index, value);
+			}
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::find_previous(const std::chrono::sys_days& sd, const bool value) const -> std::optional<std::chrono::sys_days>
+		{
+			const auto offset = _offset(sd);
+
+			auto word_index = offset / _word_size;
+			auto word = _word(word_index, value) & (~std::uint64_t{ 0u } >> (_word_size - 1uz - offset % _word_size));
+			for (;;)
+			{
+				if (word != std::uint64_t{ 0u })
+				{
+					const auto found = word_index * _word_size + _word_size - 1uz - static_cast<std::size_t>(std::countl_zero(word));
+					return _period.get_from() + std::chrono::days{ found };
+				}
+
+				if (word_index-- == 0uz)
+					return std::nullopt;
+
+				word = _word(word_index, value);
+			}
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::find_around(const std::chrono::sys_days& sd, const bool value) const
+			-> std::pair<std::optional<std::chrono::sys_days>, std::optional<std::chrono::sys_days>>
+		{
+			const auto offset = _offset(sd);
+			const auto size = _size();
+			const auto word_index = offset / _word_size;
+			const auto inner = offset % _word_size;
+
+			auto previous = std::optional<std::chrono::sys_days>{};
+			auto next = std::optional<std::chrono::sys_days>{};
+
+			// step k looks at the k-th word on either side of the one with sd (until both sides are done)
+			auto previous_done = false;
+			auto next_done = false;
+			for (auto k = 0uz; !previous_done || !next_done; ++k)
+			{
+				if (!previous_done)
+				{
+					auto word = _word(word_index - k, value);
+					if (k == 0uz)
+						word &= ~std::uint64_t{ 0u } >> (_word_size - 1uz - inner);
+
+					if (word != std::uint64_t{ 0u })
+					{
+						const auto found = (word_index - k) * _word_size + _word_size - 1uz - static_cast<std::size_t>(std::countl_zero(word));
+						previous = _period.get_from() + std::chrono::days{ found };
+						previous_done = true;
+					}
+					else
+						previous_done = k == word_index;
+				}
+
+				if (!next_done)
+				{
+					auto word = _word(word_index + k, value);
+					if (k == 0uz)
+						word &= ~std::uint64_t{ 0u } << inner;
+
+					if (word != std::uint64_t{ 0u })
+					{
+						const auto found = (word_index + k) * _word_size + static_cast<std::size_t>(std::countr_zero(word));
+						if (found < size) // not padding
+							next = _period.get_from() + std::chrono::days{ found };
+						next_done = true;
+					}
+					else
+						next_done = word_index + k + 1uz == _words;
+				}
+			}
+
+			return { previous, next };
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator|=(const time_series& ts) -> time_series&
+		{
+			_combine(ts, [](const std::uint64_t w1, const std::uint64_t w2) { return w1 | w2; });
+			return *this;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::operator&=(const time_series& ts) -> time_series&
+		{
+			_combine(ts, [](const std::uint64_t w1, const std::uint64_t w2) { return w1 & w2; });
+			return *this;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::share_pages(const time_series& ts) -> std::size_t
+		{
+			if (_period.get_from() != ts._period.get_from())
+				return 0uz;
+
+			populate();
+			_release_blocks();
+			ts.populate();
+
+			auto shared = 0uz;
+			for (auto p = 0uz; p < std::min(_pages.size(), ts._pages.size()); ++p)
+			{
+				// pages are compared as a whole, so a page past the end of the shorter one (where it only has zeros)
+				// is only shared if the longer one has no true observations there either
+				// (a page which ts does not own is only shared if this time series has no other pages it does not own)
+				const auto can_share = ts._owners[p] || !_external || _external == ts._external;
+				if (_pages[p] != ts._pages[p] && can_share && _same_page(p, ts))
+				{
+					_owners[p] = ts._owners[p];
+					_pages[p] = ts._pages[p];
+					if (!ts._owners[p])
+						_external = ts._external;
+				}
+
+				if (_pages[p] == ts._pages[p])
+					++shared;
+			}
+
+			return shared;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::count_shared_pages(const time_series& ts) const noexcept -> std::size_t
+		{
+			auto shared = 0uz;
+			for (auto p = 0uz; p < std::min(_pages.size(), ts._pages.size()); ++p)
+				if (_pages[p] == ts._pages[p])
+					++shared;
+
+			return shared;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::find_differences(const time_series& ts) const -> std::vector<std::chrono::sys_days>
+		{
+			auto ds = std::vector<std::chrono::sys_days>{};
+
+			const auto from = std::max(_period.get_from(), ts._period.get_from());
+			const auto until = std::min(_period.get_until(), ts._period.get_until());
+			if (until < from)
+				return ds;
+
+			populate();
+			ts.populate();
+
+			if (_period.get_from() != ts._period.get_from())
+			{
+				for (auto d = from; d <= until; d += std::chrono::days{ 1 })
+					if (get_unchecked(d) != ts.get_unchecked(d))
+						ds.push_back(d);
+
+				return ds;
+			}
+
+			const auto last = static_cast<std::size_t>((until - from).count());
+			const auto words = last / _word_size + 1uz;
+			for (auto first_word = 0uz; first_word < words; first_word += _words_per_page)
+			{
+				const auto p = first_word / _words_per_page;
+				if (_pages[p] == ts._pages[p])
+					continue;
+
+				for (auto w = first_word; w < std::min(first_word + _words_per_page, words); ++w)
+				{
+					auto diff = _get(w) ^ ts._get(w);
+					if (w == words - 1uz && last % _word_size != _word_size - 1uz)
+						diff &= (std::uint64_t{ 1u } << (last % _word_size + 1uz)) - 1u; // the rest is past the end of one of them
+
+					for (; diff != 0u; diff &= diff - 1u)
+						ds.push_back(from + std::chrono::days{ w * _word_size + static_cast<std::size_t>(std::countr_zero(diff)) });
+				}
+			}
+
+			return ds;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::get_chunk_size() noexcept -> std::size_t
+		{
+			return chunk_size;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::get_page_size() noexcept -> std::size_t
+		{
+			return _words_per_page * _word_size;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::get_page_words() noexcept -> std::size_t
+		{
+			return _words_per_page;
+		}
+
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_offset(const std::chrono::sys_days& sd) const -> std::size_t
+		{
+			if (!_contains(sd))
 				throw std::out_of_range{ "Request is not consistent with from/until" };
 
-			const auto days = sd - _period.get_from();
-			return days.count() % _chunk_size;
+			return static_cast<std::size_t>((sd - _period.get_from()).count());
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_contains(const std::chrono::sys_days& sd) const noexcept -> bool
+		{
+			return sd >= _period.get_from() && sd <= _period.get_until();
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_bit(const std::size_t offset) const noexcept -> bool
+		{
+			_populate(offset / _word_size, offset / _word_size);
+
+			return (_get(offset / _word_size) >> (offset % _word_size)) & std::uint64_t{ 1u };
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_get(const std::size_t word_index) const noexcept -> std::uint64_t
+		{
+			return _pages[word_index / _words_per_page][word_index % _words_per_page];
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_set(const std::size_t word_index) -> std::uint64_t&
+		{
+			_unshare(word_index / _words_per_page);
+
+			return _owners[word_index / _words_per_page]->words[word_index % _words_per_page];
+		}
+
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::_unshare(const std::size_t page_index)
+		{
+			auto& page = _owners[page_index];
+
+			// only this time series could make another copy of the page, so once it is the only one, it stays the only one
+			// (the fence makes sure whoever has just let go of the page is done reading it)
+			if (page.use_count() != 1) // shared or not owned
+			{
+				auto copy = std::make_shared<_page>();
+				std::copy_n(_pages[page_index], _words_per_page, copy->words.begin());
+				page = std::move(copy);
+				_pages[page_index] = page->words.data();
+			}
+			else
+				std::atomic_thread_fence(std::memory_order_acquire);
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_same_page(const std::size_t page_index, const time_series& ts) const noexcept -> bool
+		{
+			const auto* const words = _pages[page_index];
+			const auto* const other = ts._pages[page_index];
+
+			return words == other || std::equal(words, words + _words_per_page, other);
 		}
 
-		inline auto time_series<bool>::count(const util::days_period& p) const -> std::size_t
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_popcount(std::size_t first_word_index, std::size_t count) const noexcept -> std::size_t
+		{
+			auto result = 0uz;
+			while (count != 0uz)
+			{
+				const auto inner = first_word_index % _words_per_page;
+				const auto n = std::min(count, _words_per_page - inner);
+
+				result += util::popcount(std::span{ _pages[first_word_index / _words_per_page] + inner, n });
+
+				first_word_index += n;
+				count -= n;
+			}
+
+			return result;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_size() const noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>((_period.get_until() - _period.get_from()).count()) + 1uz;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_word(const std::size_t word_index, const bool value) const noexcept -> std::uint64_t
+		{
+			_populate(word_index, word_index);
+
+			const auto word = _get(word_index);
+			return value ? word : ~word;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_chunks_rank(const std::size_t chunk_index, const bool value) const noexcept -> std::size_t
+		{
+			if (!has_rank_index() && chunk_index != 0uz)
+				_populate(0uz, chunk_index * _words_per_chunk - 1uz);
+
+			const auto trues = has_rank_index() ?
+				_ranks[chunk_index] :
+				_popcount(0uz, chunk_index * _words_per_chunk);
+
+			return value ? trues : chunk_index * chunk_size - trues;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_blocks_rank(const std::size_t block_index) const noexcept -> std::size_t
+		{
+			// from the last block which is known (the first one always is)
+			auto b = std::min(_ranked_blocks.load(std::memory_order_acquire), block_index);
+			auto result = _block_ranks[b].load(std::memory_order_relaxed);
+			if (b == block_index)
+				return result;
+
+			for (; b < block_index; ++b)
+			{
+				const auto first = b * _words_per_block;
+				const auto last = std::min(first + _words_per_block, _words) - 1uz;
+
+				_populate(first, last);
+				result += _popcount(first, last - first + 1uz);
+				_block_ranks[b + 1uz].store(result, std::memory_order_relaxed);
+			}
+
+			// another thread could have got further already
+			auto known = _ranked_blocks.load(std::memory_order_relaxed);
+			while (known < block_index && !_ranked_blocks.compare_exchange_weak(known, block_index, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+
+			return result;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_block_count() const noexcept -> std::size_t
+		{
+			return (_words + _words_per_block - 1uz) / _words_per_block;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_rank(const std::size_t offset) const noexcept -> std::size_t
+		{
+			const auto chunk_index = offset / chunk_size;
+			const auto word_index = offset / _word_size;
+			const auto inner = offset % _word_size;
+
+			auto result = _ranks[chunk_index];
+
+			// whole words from the start of the chunk
+			if constexpr (_words_per_chunk > 1uz)
+			{
+				const auto first = chunk_index * _words_per_chunk;
+				result += _popcount(first, word_index - first);
+			}
+
+			if (inner != 0uz) // offset just past the last chunk does not have a word to look into
+			{
+				const auto mask = (std::uint64_t{ 1u } << inner) - std::uint64_t{ 1u };
+				result += static_cast<std::size_t>(std::popcount(_get(word_index) & mask));
+			}
+
+			return result;
+		}
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::count(const util::days_period& p) const -> std::size_t
 		{
 			return count(util::period<std::chrono::sys_days>{ p.get_from(), p.get_until() });
 		}
@@ -288,46 +1368,166 @@ namespace gregorian
 		// for rule based calendars with adjustments for holidays that fall on weekends
 		// we also know the number of additional holidays per year (which is just the number of rules)
 		// which can further optimise the calculation
-		inline auto time_series<bool>::count(const util::period<std::chrono::sys_days>& p) const -> std::size_t
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::count(const util::period<std::chrono::sys_days>& p) const -> std::size_t
 		{
-			using namespace std::chrono;
+			// both checks are done here, so the rest can stay unchecked
+			if (p.get_from() < _period.get_from() || p.get_until() > _period.get_until())
+				throw std::out_of_range{ "Request is not consistent with from/until" };
 
-			auto result = 0uz;
+			const auto from_offset = static_cast<std::size_t>((p.get_from() - _period.get_from()).count());
+			const auto until_offset = static_cast<std::size_t>((p.get_until() - _period.get_from()).count());
 
-			const auto from = p.get_from();
-			const auto from_chunk_index = _index_outer(from);
+			if (has_rank_index())
+				return _rank(until_offset + 1uz) - _rank(from_offset);
 
-			const auto until = p.get_until();
-			const auto until_chunk_index = _index_outer(until);
+			const auto from_word_index = from_offset / _word_size;
+			const auto until_word_index = until_offset / _word_size;
 
-			// handle the chunk that contains from
-			const auto& from_chunk = _observations[from_chunk_index];
-			for (auto i = _index_inner(from); i < _chunk_size; ++i)
-				if (from_chunk[i])
-					result++;
-			// naive implementation to start with
+			_populate(from_word_index, until_word_index);
 
-			// full chunks in the middle (after the from chunk, but including the chunk that contains until)
-			for (
-				auto j = from_chunk_index + 1uz;
-				j <= until_chunk_index;
-				++j
-			)
-				result += _observations[j].count();
-			// naive implementation to start with
+			const auto from_mask = ~std::uint64_t{ 0u } << (from_offset % _word_size);
+			const auto until_mask = ~std::uint64_t{ 0u } >> (_word_size - 1uz - until_offset % _word_size);
+
+			// from and until in the same word
+			if (from_word_index == until_word_index)
+				return static_cast<std::size_t>(std::popcount(_get(from_word_index) & from_mask & until_mask));
 
-			// handle the chunk that contains until
-			const auto& until_chunk = _observations[until_chunk_index];
-			for (auto i = _index_inner(until) + 1uz; i < _chunk_size; ++i)
-				if (until_chunk[i])
-					result--;
-			// naive implementation to start with
+			// the words which contain from and until
+			auto result = static_cast<std::size_t>(
+				std::popcount(_get(from_word_index) & from_mask) +
+				std::popcount(_get(until_word_index) & until_mask)
+			);
 
-			// can we factor out some common code for the first and last parts?
+			// full words in between
+			result += _popcount(from_word_index + 1uz, until_word_index - from_word_index - 1uz);
 
 			return result;
 		}
 
+
+		template<std::size_t chunk_size>
+		auto time_series<bool, chunk_size>::_bits(const std::size_t offset) const noexcept -> std::uint64_t
+		{
+			const auto word_index = offset / _word_size;
+			const auto inner = offset % _word_size;
+
+			auto bits = _get(word_index) >> inner;
+			if (inner != 0uz && word_index + 1uz < _words)
+				bits |= _get(word_index + 1uz) << (_word_size - inner);
+
+			return bits;
+		}
+
+		template<std::size_t chunk_size>
+		template<typename BinaryOperation>
+		void time_series<bool, chunk_size>::_combine(const time_series& ts, BinaryOperation op)
+		{
+			if (_period.get_from() < ts._period.get_from() || _period.get_until() > ts._period.get_until())
+				throw std::out_of_range{ "Request is not consistent with from/until" };
+
+			const auto shift = static_cast<std::size_t>((_period.get_from() - ts._period.get_from()).count());
+			const auto size = _size();
+			const auto words = (size + _word_size - 1uz) / _word_size;
+
+			populate(); // so the generator does not overwrite the result later
+			_release_blocks();
+			ts._populate(shift / _word_size, std::min((shift + size) / _word_size, ts._words - 1uz));
+
+			for (auto p = 0uz; p < _owners.size(); ++p)
+				_unshare(p);
+
+			for (auto j = 0uz; j < words; ++j)
+			{
+				auto& word = _owners[j / _words_per_page]->words[j % _words_per_page];
+				word = op(word, ts._bits(shift + j * _word_size));
+			}
+
+			// padding stays clear (whole chunks are popcounted by the rank index)
+			if (size % _word_size != 0uz)
+				_set(words - 1uz) &= (std::uint64_t{ 1u } << (size % _word_size)) - std::uint64_t{ 1u };
+
+			_ranked.store(false, std::memory_order_relaxed);
+			_ranks.clear();
+			_ranked_blocks.store(0uz, std::memory_order_relaxed);
+		}
+
+
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::_populate(const std::size_t first_word_index, const std::size_t last_word_index) const noexcept
+		{
+			if (_blocks.empty()) // not lazy
+				return;
+
+			if (_populated_blocks.load(std::memory_order_acquire) == _blocks.size()) // all of it already
+				return;
+
+			for (auto b = first_word_index / _words_per_block; b <= last_word_index / _words_per_block; ++b)
+				_populate_block(b);
+		}
+
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::_populate_block(const std::size_t block_index) const noexcept
+		{
+			auto& state = _blocks[block_index];
+
+			auto s = state.load(std::memory_order_acquire);
+			if (s == _populated)
+				return;
+
+			if (s == _unpopulated && state.compare_exchange_strong(s, _populating, std::memory_order_acquire))
+			{
+				const auto size = _size();
+				const auto first = block_index * _words_per_block;
+				const auto last = std::min(first + _words_per_block, _words);
+				for (auto j = first; j < last; ++j)
+				{
+					auto word = std::uint64_t{ 0u };
+					for (auto i = 0uz; i < _word_size && j * _word_size + i < size; ++i)
+						if (_generator(_period.get_from() + std::chrono::days{ j * _word_size + i }))
+							word |= std::uint64_t{ 1u } << i;
+
+					_owners[j / _words_per_page]->words[j % _words_per_page] = word; // not shared while being populated
+				}
+
+				state.store(_populated, std::memory_order_release);
+				state.notify_all();
+
+				// whoever populates the last block indexes the whole time series
+				if (_populated_blocks.fetch_add(1uz, std::memory_order_acq_rel) + 1uz == _blocks.size())
+				{
+					try
+					{
+						_publish_rank_index();
+					}
+					catch (...)
+					{
+						// the index is only an optimisation
+					}
+				}
+
+				return;
+			}
+
+			// another thread is populating it
+			while (s != _populated)
+			{
+				state.wait(s, std::memory_order_acquire);
+				s = state.load(std::memory_order_acquire);
+			}
+		}
+
+		template<std::size_t chunk_size>
+		void time_series<bool, chunk_size>::_release_blocks() noexcept
+		{
+			if (_blocks.empty() || _populated_blocks.load(std::memory_order_acquire) != _blocks.size())
+				return;
+
+			_generator = generator{};
+			_blocks.clear();
+			_populated_blocks.store(0uz, std::memory_order_relaxed);
+		}
+
 	}
 
 }
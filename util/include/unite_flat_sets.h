@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <flat_set>
+#include <vector>
+#include <span>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		template <typename Key>
+		[[nodiscard]] auto unite_flat_sets(const std::flat_set<Key>& a, const std::flat_set<Key>& b) -> std::flat_set<Key>
+		{
+			auto result = std::vector<Key>{};
+			result.reserve(a.size() + b.size());
+
+			// both are sorted, so a single O(N + M) pass
+			std::ranges::set_union(a, b, std::back_inserter(result));
+
+			return std::flat_set<Key>(std::sorted_unique, std::move(result));
+		}
+
+		// k-way merge with a min heap of the next key of each set, O(N log k)
+		// (rather than k - 1 two way merges, which are O(N k))
+		template <typename Key>
+		[[nodiscard]] auto unite_flat_sets(std::span<const std::flat_set<Key>* const> sets) -> std::flat_set<Key>
+		{
+			auto size = std::size_t{ 0u };
+			for (const auto* set : sets)
+				size += set->size();
+
+			auto result = std::vector<Key>{};
+			result.reserve(size);
+
+			using cursor = std::pair<typename std::flat_set<Key>::const_iterator, typename std::flat_set<Key>::const_iterator>; // next and end
+			const auto greater = [](const cursor& c1, const cursor& c2) { return *c2.first < *c1.first; };
+
+			auto cursors = std::vector<cursor>{};
+			cursors.reserve(sets.size());
+			for (const auto* set : sets)
+				if (!set->empty())
+					cursors.emplace_back(set->cbegin(), set->cend());
+
+			auto heap = std::priority_queue<cursor, std::vector<cursor>, decltype(greater)>{ greater, std::move(cursors) };
+			while (!heap.empty())
+			{
+				auto c = heap.top();
+				heap.pop();
+
+				if (result.empty() || result.back() < *c.first) // the same key can come from several sets
+					result.push_back(*c.first);
+
+				if (++c.first != c.second)
+					heap.push(std::move(c));
+			}
+
+			return std::flat_set<Key>(std::sorted_unique, std::move(result));
+		}
+
+	}
+
+}
@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <eytzinger_set.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+
+using namespace std;
+using namespace gregorian::util;
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		TEST(eytzinger_set, constructor1)
+		{
+			const auto s = eytzinger_set<int32_t>{};
+
+			EXPECT_EQ(0uz, s.size());
+			EXPECT_FALSE(s.contains(0));
+		}
+
+		TEST(eytzinger_set, contains1)
+		{
+			// every size up to a few full levels of the tree, every key in and around the set
+			for (auto n = 0; n < 70; ++n)
+			{
+				auto keys = vector<int32_t>{};
+				for (auto i = 0; i < n; ++i)
+					keys.push_back(-50 + 3 * i + i % 2);
+
+				const auto s = eytzinger_set<int32_t>{ keys };
+				EXPECT_EQ(keys.size(), s.size());
+
+				for (auto key = -60; key < 200; ++key)
+					EXPECT_EQ(ranges::binary_search(keys, key), s.contains(key));
+			}
+		}
+
+		TEST(eytzinger_set, operator_equal_to_1)
+		{
+			const auto keys = vector<int32_t>{ 1, 5, 9 };
+
+			EXPECT_EQ(eytzinger_set<int32_t>{ keys }, eytzinger_set<int32_t>{ keys });
+			EXPECT_NE(eytzinger_set<int32_t>{ keys }, eytzinger_set<int32_t>{});
+		}
+
+	}
+
+}
@@ -25,6 +25,12 @@
 #include <gtest/gtest.h>
 
 #include <flat_set>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
 
 using namespace std;
 
@@ -51,6 +57,73 @@ namespace gregorian
 			EXPECT_EQ(expected3, intersect_flat_sets(set1, set1));
 		}
 
+		template<typename Key, typename Make>
+		static auto _make_set(const size_t n, const size_t step, const size_t shift, const Make& make) -> flat_set<Key>
+		{
+			auto keys = vector<Key>{};
+			for (auto i = 0uz; i < n; ++i)
+				keys.push_back(make(i * step + shift));
+
+			return flat_set<Key>{ keys.begin(), keys.end() };
+		}
+
+		template<typename Key>
+		static auto _expected(const flat_set<Key>& a, const flat_set<Key>& b) -> flat_set<Key>
+		{
+			auto result = vector<Key>{};
+			ranges::set_intersection(a, b, back_inserter(result));
+
+			return flat_set<Key>{ sorted_unique, std::move(result) };
+		}
+
+		TEST(intersect_flat_sets, intersect_flat_sets2)
+		{
+			const auto make = [](const size_t i) { return static_cast<int32_t>(i) - 1000; };
+			const auto kernels = { intersect_kernel::linear, intersect_kernel::galloping, intersect_kernel::simd };
+
+			// sizes both similar and very different, with tails which do not fill a block of 4
+			for (const auto n1 : { 0uz, 1uz, 3uz, 4uz, 5uz, 17uz, 100uz, 1000uz })
+				for (const auto n2 : { 0uz, 1uz, 7uz, 64uz, 1001uz, 5000uz })
+					for (const auto step : { 1uz, 2uz, 3uz, 97uz })
+					{
+						const auto set1 = _make_set<int32_t>(n1, step, 1uz, make);
+						const auto set2 = _make_set<int32_t>(n2, 2uz, 0uz, make);
+						const auto expected = _expected(set1, set2);
+
+						EXPECT_EQ(expected, intersect_flat_sets(set1, set2));
+						EXPECT_EQ(expected, intersect_flat_sets(set2, set1));
+						for (const auto k : kernels)
+						{
+							EXPECT_EQ(expected, intersect_flat_sets(set1, set2, k));
+							EXPECT_EQ(expected, intersect_flat_sets(set2, set1, k));
+						}
+					}
+		}
+
+		TEST(intersect_flat_sets, intersect_flat_sets3)
+		{
+			// keys which simd does not support
+			const auto make = [](const size_t i) { return to_string(i + 100000uz); };
+			const auto kernels = { intersect_kernel::linear, intersect_kernel::galloping, intersect_kernel::simd };
+
+			const auto set1 = _make_set<string>(10uz, 37uz, 0uz, make);
+			const auto set2 = _make_set<string>(1000uz, 1uz, 0uz, make);
+			const auto expected = _expected(set1, set2);
+			EXPECT_EQ(10uz, expected.size());
+
+			EXPECT_EQ(expected, intersect_flat_sets(set1, set2));
+			for (const auto k : kernels)
+				EXPECT_EQ(expected, intersect_flat_sets(set1, set2, k));
+
+			const auto set3 = _make_set<int64_t>(100uz, 3uz, 0uz, [](const size_t i) { return static_cast<int64_t>(i); });
+			const auto set4 = _make_set<int64_t>(100uz, 5uz, 0uz, [](const size_t i) { return static_cast<int64_t>(i); });
+			const auto expected34 = _expected(set3, set4);
+			EXPECT_EQ(20uz, expected34.size());
+
+			for (const auto k : kernels)
+				EXPECT_EQ(expected34, intersect_flat_sets(set3, set4, k));
+		}
+
 	}
 
 }
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <popcount.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <bit>
+#include <cstdint>
+
+
+using namespace std;
+using namespace gregorian::util;
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		// some "random" words (xorshift)
+		static auto _make_words(const size_t n) -> vector<uint64_t>
+		{
+			auto words = vector<uint64_t>(n);
+
+			auto x = uint64_t{ 88172645463325252u };
+			for (auto& w : words)
+			{
+				x ^= x << 13;
+				x ^= x >> 7;
+				x ^= x << 17;
+				w = x;
+			}
+
+			return words;
+		}
+
+		static auto _naive_popcount(const vector<uint64_t>& words) -> size_t
+		{
+			auto result = 0uz;
+			for (const auto w : words)
+				for (auto i = 0; i < 64; ++i)
+					if ((w >> i) & uint64_t{ 1u })
+						++result;
+
+			return result;
+		}
+
+		TEST(popcount, popcount_1)
+		{
+			// all lengths around the kernel widths and the threshold for dispatch
+			for (auto n = 0uz; n <= 70uz; ++n)
+			{
+				const auto words = _make_words(n);
+				EXPECT_EQ(_naive_popcount(words), popcount(words));
+			}
+		}
+
+		TEST(popcount, popcount_2)
+		{
+			// every kernel which this CPU supports
+			for (
+				auto k = popcount_kernel::scalar;
+				k <= get_popcount_kernel();
+				k = static_cast<popcount_kernel>(static_cast<int>(k) + 1)
+			)
+				for (auto n = 0uz; n <= 70uz; ++n)
+				{
+					const auto words = _make_words(n);
+					EXPECT_EQ(_naive_popcount(words), popcount(words, k));
+
+					const auto ones = vector<uint64_t>(n, ~uint64_t{ 0u });
+					EXPECT_EQ(64uz * n, popcount(ones, k));
+				}
+		}
+
+	}
+
+}
@@ -27,6 +27,17 @@
 
 #include <chrono>
 #include <stdexcept>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <span>
+#include <array>
+#include <cstdint>
 
 
 using namespace std;
@@ -194,6 +205,36 @@ namespace gregorian
 			EXPECT_EQ(true, ts[sd]);
 		}
 
+		TEST(time_series_bool, get_unchecked_1)
+		{
+			auto ts = time_series<bool>{ days_period{ 2023y / January / 1d, 2023y / June / 5d } };
+
+			ts[2023y / January / 3d] = true;
+			ts[2023y / June / 5d] = true;
+
+			EXPECT_FALSE(ts.get_unchecked(sys_days{ 2023y / January / 1d }));
+			EXPECT_TRUE(ts.get_unchecked(sys_days{ 2023y / January / 3d }));
+			EXPECT_TRUE(ts.get_unchecked(sys_days{ 2023y / June / 5d }));
+		}
+
+		TEST(time_series_bool, try_get_1)
+		{
+			auto ts = time_series<bool>{ days_period{ 2023y / January / 1d, 2023y / June / 5d } };
+
+			ts[2023y / January / 3d] = true;
+
+			EXPECT_EQ(false, ts.try_get(sys_days{ 2023y / January / 1d }));
+			EXPECT_EQ(true, ts.try_get(sys_days{ 2023y / January / 3d }));
+
+			const auto before = ts.try_get(sys_days{ 2022y / December / 31d });
+			ASSERT_FALSE(before.has_value());
+			EXPECT_EQ(errc::argument_out_of_domain, before.error());
+
+			const auto after = ts.try_get(sys_days{ 2023y / June / 6d });
+			ASSERT_FALSE(after.has_value());
+			EXPECT_EQ(errc::argument_out_of_domain, after.error());
+		}
+
 		TEST(time_series_bool, count_1)
 		{
 			auto ts = time_series<bool>{ days_period{ 2023y / January / 1d, 2023y / June / 5d } };
@@ -224,9 +265,569 @@ namespace gregorian
 			EXPECT_EQ(2, ts.count(p));
 		}
 
+		TEST(time_series_bool, count_3)
+		{
+			const auto f = sys_days{ 2023y / January / 1d };
+			const auto u = sys_days{ 2025y / June / 5d };
+
+			auto ts = time_series<bool>{ days_period{ f, u } };
+			for (auto d = f; d <= u; d += days{ 1 })
+				ts[d] = (d - f).count() % 3 == 0 || (d - f).count() % 7 == 0;
+
+			const auto expected = ts; // without the rank index
+
+			ts.build_rank_index();
+			EXPECT_TRUE(ts.has_rank_index());
+			EXPECT_TRUE(!expected.has_rank_index());
+
+			// from/until on and around the chunk boundaries
+			for (auto from = f; from <= f + days{ 200 }; from += days{ 1 })
+				for (auto until : { from, from + days{ 63 }, from + days{ 64 }, from + days{ 65 }, u })
+					EXPECT_EQ(expected.count(period{ from, until }), ts.count(period{ from, until }));
+
+			EXPECT_THROW(static_cast<void>(ts.count(period{ f - days{ 1 }, u })), out_of_range);
+			EXPECT_THROW(static_cast<void>(ts.count(period{ f, u + days{ 1 } })), out_of_range);
+		}
+
+		TEST(time_series_bool, build_rank_index_1)
+		{
+			auto ts = time_series<bool>{ days_period{ 2023y / January / 1d, 2023y / June / 5d } };
+			EXPECT_FALSE(ts.has_rank_index());
+
+			ts.build_rank_index();
+			EXPECT_TRUE(ts.has_rank_index());
+
+			const auto indexed = ts;
+
+			ts[2023y / January / 3d] = true; // any write drops the index
+			EXPECT_FALSE(ts.has_rank_index());
+			EXPECT_NE(indexed, ts);
+
+			ts[2023y / January / 3d] = false;
+			EXPECT_EQ(indexed, ts); // index is not part of the value
+		}
+
+		TEST(time_series_bool, rank_select_1)
+		{
+			const auto f = sys_days{ 2023y / January / 1d };
+			const auto u = sys_days{ 2023y / December / 31d };
+
+			auto ts = time_series<bool>{ days_period{ f, u } };
+			for (auto d = f; d <= u; d += days{ 1 })
+				ts[d] = (d - f).count() % 5 == 0 || (d - f).count() % 11 == 0;
+
+			auto indexed = ts;
+			indexed.build_rank_index();
+
+			auto trues = 0uz;
+			auto falses = 0uz;
+			for (auto d = f; d <= u; d += days{ 1 })
+			{
+				EXPECT_EQ(trues, ts.rank(d, true));
+				EXPECT_EQ(falses, ts.rank(d, false));
+				EXPECT_EQ(trues, indexed.rank(d, true));
+				EXPECT_EQ(falses, indexed.rank(d, false));
+
+				if (ts[d])
+				{
+					EXPECT_EQ(d, ts.select(trues, true));
+					EXPECT_EQ(d, indexed.select(trues, true));
+					++trues;
+				}
+				else
+				{
+					EXPECT_EQ(d, ts.select(falses, false));
+					EXPECT_EQ(d, indexed.select(falses, false));
+					++falses;
+				}
+			}
+
+			EXPECT_THROW(static_cast<void>(indexed.rank(f - days{ 1 }, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(indexed.rank(u + days{ 1 }, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(indexed.select(trues, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(indexed.select(falses, false)), out_of_range); // padding is not selected
+			EXPECT_THROW(static_cast<void>(ts.select(trues, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(ts.select(falses, false)), out_of_range);
+		}
+
+		TEST(time_series_bool, find_1)
+		{
+			const auto f = sys_days{ 2023y / January / 1d };
+			const auto u = sys_days{ 2023y / December / 31d };
+
+			for (const auto value : { true, false })
+			{
+				// sparse observations equal to value (some further apart than a chunk)
+				auto ts = time_series<bool>{ days_period{ f, u } };
+				for (auto d = f; d <= u; d += days{ 1 })
+				{
+					const auto i = (d - f).count();
+					ts[d] = (i == 3 || i == 70 || i == 200 || i == 201 || i == 300) == value;
+				}
+
+				for (auto d = f; d <= u; d += days{ 1 })
+				{
+					auto next = optional<sys_days>{};
+					for (auto n = d; n <= u && !next; n += days{ 1 })
+						if (ts[n] == value)
+							next = n;
+
+					auto previous = optional<sys_days>{};
+					for (auto p = d; p >= f && !previous; p -= days{ 1 })
+						if (ts[p] == value)
+							previous = p;
+
+					EXPECT_EQ(next, ts.find_next(d, value));
+					EXPECT_EQ(previous, ts.find_previous(d, value));
+					EXPECT_EQ(make_pair(previous, next), ts.find_around(d, value));
+				}
+			}
+
+			const auto ts = time_series<bool>{ days_period{ f, u } };
+			EXPECT_EQ(nullopt, ts.find_next(f, true));
+			EXPECT_EQ(nullopt, ts.find_next(u, true)); // padding is not found either
+			EXPECT_EQ(u, ts.find_next(u, false));
+			EXPECT_THROW(static_cast<void>(ts.find_next(u + days{ 1 }, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(ts.find_previous(f - days{ 1 }, true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(ts.find_around(f - days{ 1 }, true)), out_of_range);
+		}
+
 		TEST(time_series_bool, get_chunk_size_1)
 		{
 			EXPECT_EQ(64, time_series<bool>::get_chunk_size());
+			EXPECT_EQ(128, (time_series<bool, 128>::get_chunk_size()));
+			EXPECT_EQ(256, (time_series<bool, 256>::get_chunk_size()));
+			EXPECT_EQ(512, (time_series<bool, 512>::get_chunk_size()));
+		}
+
+		template<size_t chunk_size>
+		void _expect_same_as_default(const sys_days& f, const sys_days& u)
+		{
+			auto expected = time_series<bool>{ days_period{ f, u } };
+			auto ts = time_series<bool, chunk_size>{ days_period{ f, u } };
+			for (auto d = f; d <= u; d += days{ 1 })
+			{
+				const auto i = (d - f).count();
+				expected[d] = i % 3 == 0 || i % 7 == 0 || (i / 100) % 4 == 0;
+				ts[d] = expected[d];
+			}
+
+			for (const auto with_rank_index : { false, true })
+			{
+				if (with_rank_index)
+				{
+					expected.build_rank_index();
+					ts.build_rank_index();
+				}
+
+				for (auto from = f; from <= u; from += days{ 13 })
+					for (auto until = from; until <= u; until += days{ 29 })
+						EXPECT_EQ(expected.count(period{ from, until }), ts.count(period{ from, until }));
+
+				for (auto d = f; d <= u; d += days{ 1 })
+				{
+					EXPECT_EQ(expected.rank(d, true), ts.rank(d, true));
+					EXPECT_EQ(expected.find_next(d, false), ts.find_next(d, false));
+					EXPECT_EQ(expected.find_around(d, true), ts.find_around(d, true));
+				}
+
+				const auto trues = expected.count(period{ f, u });
+				for (auto r = 0uz; r < trues; r += 5uz)
+					EXPECT_EQ(expected.select(r, true), ts.select(r, true));
+				EXPECT_THROW(static_cast<void>(ts.select(trues, true)), out_of_range);
+				EXPECT_THROW(static_cast<void>(ts.select(static_cast<size_t>((u - f).count()) + 1uz - trues, false)), out_of_range);
+			}
+		}
+
+		TEST(time_series_bool, chunk_size_1)
+		{
+			// period which does not fill the last chunk (so there is padding of a few words)
+			const auto f = sys_days{ 2023y / January / 1d };
+			const auto u = sys_days{ 2026y / March / 17d };
+
+			_expect_same_as_default<128>(f, u);
+			_expect_same_as_default<256>(f, u);
+			_expect_same_as_default<512>(f, u);
+		}
+
+		TEST(time_series_bool, words_1)
+		{
+			const auto p = days_period{ 2023y / January / 1d, 2023y / March / 10d }; // 69 days, so 2 words
+			const auto words = vector<uint64_t>{ 0x8000000000000001u, 0xffffffffffffffffu };
+
+			const auto ts = time_series<bool>{ p, words };
+			EXPECT_FALSE(ts.is_lazy());
+			EXPECT_TRUE(ts[2023y / January / 1d]);
+			EXPECT_FALSE(ts[2023y / January / 2d]);
+			EXPECT_TRUE(ts[2023y / March / 5d]);
+			EXPECT_TRUE(ts[2023y / March / 10d]);
+			EXPECT_EQ(7uz, ts.count(p)); // bits past the end of the period are dropped
+
+			EXPECT_THROW(static_cast<void>(time_series<bool>{ p, span{ words }.first(1uz) }), invalid_argument);
+		}
+
+		TEST(time_series_bool, words_2)
+		{
+			// words which are referred to rather than copied (the whole pages of them)
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d }; // 36525 days, 571 words, so 8 whole pages
+			auto words = make_shared<vector<uint64_t>>(571uz);
+			for (auto j = 0uz; j < words->size(); ++j)
+				(*words)[j] = j * 0x9e3779b97f4a7c15u;
+			words->back() &= (uint64_t{ 1u } << (36525uz % 64uz)) - 1u;
+
+			const auto copied = time_series<bool>{ p, *words };
+			auto ts = time_series<bool>{ p, *words, words };
+			EXPECT_EQ(copied, ts);
+			EXPECT_EQ(copied.count(p), ts.count(p));
+
+			// written to through copies of pages
+			const auto d = sys_days{ 2024y / June / 1d };
+			const auto before = *words;
+			ts[d] = !ts[d];
+			EXPECT_NE(copied, ts);
+			EXPECT_EQ(before, *words);
+
+			// copies keep the words alive
+			auto copy = optional<time_series<bool>>{};
+			{
+				const auto referring = time_series<bool>{ p, *words, words };
+				copy.emplace(referring);
+			}
+			words.reset();
+			EXPECT_EQ(copied, *copy);
+
+			const auto all = vector<uint64_t>(571uz, ~uint64_t{ 0u });
+			EXPECT_THROW(static_cast<void>(time_series<bool>{ p, all, nullptr }), invalid_argument); // bits past the end
+			EXPECT_THROW(static_cast<void>(time_series<bool>{ p, span{ all }.first(570uz), nullptr }), invalid_argument);
+		}
+
+		TEST(time_series_bool, words_3)
+		{
+			// whole pages which are referred to, a page referred to by two time series is shared by them
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d }; // 36525 days, 571 words, so 9 pages
+			const auto page_words = time_series<bool>::get_page_words();
+			auto words = make_shared<vector<uint64_t>>(9uz * page_words);
+			for (auto j = 0uz; j < 571uz; ++j)
+				(*words)[j] = j * 0x9e3779b97f4a7c15u;
+			(*words)[570uz] &= (uint64_t{ 1u } << (36525uz % 64uz)) - 1u;
+
+			// the same pages but the second one (all ones)
+			auto pages1 = vector<const uint64_t*>{};
+			for (auto page = 0uz; page < 9uz; ++page)
+				pages1.push_back(words->data() + page * page_words);
+			auto pages2 = pages1;
+			const auto ones = make_shared<vector<uint64_t>>(page_words, ~uint64_t{ 0u });
+			pages2[1uz] = ones->data();
+
+			const auto ts1 = time_series<bool>{ p, pages1, words };
+			const auto ts2 = time_series<bool>{ p, pages2, words };
+			EXPECT_EQ((time_series<bool>{ p, span{ *words }.first(571uz) }), ts1);
+			EXPECT_EQ(8uz, ts1.count_shared_pages(ts2));
+			EXPECT_EQ(page_words * 64uz, ts2.count(period{ sys_days{ p.get_from() } + days{ page_words * 64uz }, sys_days{ p.get_from() } + days{ 2uz * page_words * 64uz - 1uz } }));
+
+			EXPECT_THROW(static_cast<void>(time_series<bool>{ p, span{ pages1 }.first(8uz), nullptr }), invalid_argument);
+			auto pages3 = pages1;
+			pages3.back() = ones->data();
+			EXPECT_THROW(static_cast<void>(time_series<bool>{ p, pages3, nullptr }), invalid_argument); // bits past the end
+		}
+
+
+		TEST(time_series_bool, pages_1)
+		{
+			// copies share pages until they write to them
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d }; // 36525 days, so 9 pages
+			const auto pages = (36525uz + time_series<bool>::get_page_size() - 1uz) / time_series<bool>::get_page_size();
+			EXPECT_EQ(4096uz, time_series<bool>::get_page_size());
+
+			auto ts = time_series<bool>{ p };
+			for (auto d = sys_days{ p.get_from() }; d <= sys_days{ p.get_until() }; d += days{ 1 })
+				ts[d] = d.time_since_epoch().count() % 7 == 2;
+
+			auto copy = ts;
+			EXPECT_EQ(ts, copy);
+			EXPECT_EQ(pages, copy.share_pages(ts)); // all of them already
+
+			const auto d = sys_days{ 2024y / June / 1d };
+			copy[d] = !ts[d];
+			EXPECT_NE(ts[d], copy[d]);
+			EXPECT_NE(ts, copy);
+			EXPECT_EQ(pages - 1uz, copy.share_pages(ts)); // all but the one with d
+
+			copy[d] = ts[d];
+			EXPECT_EQ(ts, copy);
+			EXPECT_EQ(pages, copy.share_pages(ts)); // the same again
+
+			// writes to ts do not show through copy
+			ts[d] = !ts[d];
+			EXPECT_NE(ts, copy);
+			EXPECT_EQ(ts.count(p), ts[d] ? copy.count(p) + 1uz : copy.count(p) - 1uz);
+
+			// different start days do not share
+			auto other = time_series<bool>{ days_period{ 2000y / January / 2d, 2099y / December / 31d } };
+			EXPECT_EQ(0uz, other.share_pages(ts));
+		}
+
+		TEST(time_series_bool, pages_2)
+		{
+			// a copy of a lazy time series only shares the pages all of whose blocks are populated
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d };
+			const auto is_set = [](const sys_days& sd) { return sd.time_since_epoch().count() % 5 == 1; };
+
+			const auto ts = time_series<bool>{ p, is_set };
+			static_cast<void>(ts[2024y / June / 1d]);
+
+			const auto copy1 = ts;
+			EXPECT_FALSE(copy1.is_populated());
+			EXPECT_EQ(0uz, copy1.count_shared_pages(ts));
+
+			// the first page and the first days of the second one (as a block can span two pages)
+			const auto page = days{ time_series<bool>::get_page_size() };
+			static_cast<void>(ts.count(period{ sys_days{ p.get_from() }, sys_days{ p.get_from() } + page + days{ 100 } }));
+
+			const auto copy = ts;
+			EXPECT_FALSE(copy.is_populated());
+			EXPECT_EQ(1uz, copy.count_shared_pages(ts));
+			EXPECT_EQ(0uz, copy.count_shared_pages(copy1));
+
+			auto expected = time_series<bool>{ p };
+			for (auto d = sys_days{ p.get_from() }; d <= sys_days{ p.get_until() }; d += days{ 1 })
+				expected[d] = is_set(d);
+
+			EXPECT_EQ(9uz, expected.share_pages(ts)); // populates ts
+			EXPECT_TRUE(ts.is_populated());
+			EXPECT_EQ(expected, ts);
+			EXPECT_EQ(expected, copy);
+			EXPECT_EQ(expected, copy1);
+
+			// writes to expected do not show through ts
+			expected[2050y / January / 1d] = !is_set(sys_days{ 2050y / January / 1d });
+			EXPECT_NE(expected, ts);
+		}
+
+
+		TEST(time_series_bool, find_differences_1)
+		{
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d };
+			const auto is_set = [](const sys_days& sd) { return sd.time_since_epoch().count() % 5 == 1; };
+
+			const auto ts1 = time_series<bool>{ p, is_set };
+			EXPECT_TRUE(ts1.find_differences(ts1).empty());
+
+			auto ts2 = ts1;
+			const auto changed = array{ sys_days{ 2000y / January / 1d }, sys_days{ 2024y / June / 3d }, sys_days{ 2024y / June / 4d }, sys_days{ 2099y / December / 31d } };
+			for (const auto& d : changed)
+				ts2[d] = !ts2[d];
+
+			const auto ds = ts1.find_differences(ts2);
+			EXPECT_TRUE(ranges::equal(changed, ds));
+			EXPECT_TRUE(ranges::equal(changed, ts2.find_differences(ts1)));
+
+			// over the common period only, also when the time series do not start on the same day
+			auto ts3 = time_series<bool>{ days_period{ 2024y / January / 2d, 2050y / December / 31d } };
+			for (auto d = sys_days{ ts3.get_period().get_from() }; d <= sys_days{ ts3.get_period().get_until() }; d += days{ 1 })
+				ts3[d] = is_set(d);
+			ts3[2030y / May / 5d] = !ts3[2030y / May / 5d];
+
+			const auto expected = array{ sys_days{ 2024y / June / 3d }, sys_days{ 2024y / June / 4d }, sys_days{ 2030y / May / 5d } };
+			EXPECT_TRUE(ranges::equal(expected, ts2.find_differences(ts3)));
+			EXPECT_TRUE(ranges::equal(expected, ts3.find_differences(ts2)));
+		}
+
+
+		TEST(time_series_bool, lazy_1)
+		{
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d };
+			const auto is_set = [](const sys_days& sd) { return sd.time_since_epoch().count() % 7 == 2; };
+
+			auto expected = time_series<bool>{ p };
+			for (auto d = sys_days{ p.get_from() }; d <= sys_days{ p.get_until() }; d += days{ 1 })
+				expected[d] = is_set(d);
+
+			const auto ts = time_series<bool>{ p, is_set };
+			EXPECT_TRUE(ts.is_lazy());
+			EXPECT_FALSE(ts.is_populated());
+			EXPECT_FALSE(expected.is_lazy());
+			EXPECT_TRUE(expected.is_populated());
+
+			// a few years around a day do not populate the rest
+			const auto d = sys_days{ 2024y / June / 1d };
+			EXPECT_EQ(expected[d], ts[d]);
+			EXPECT_EQ(expected.count(period{ d - days{ 500 }, d + days{ 500 } }), ts.count(period{ d - days{ 500 }, d + days{ 500 } }));
+			EXPECT_EQ(expected.find_around(d, true), ts.find_around(d, true));
+			EXPECT_FALSE(ts.is_populated());
+			EXPECT_FALSE(ts.has_rank_index());
+
+			// a copy keeps what has been populated so far
+			const auto copy = ts;
+			EXPECT_EQ(expected[d], copy[d]);
+			EXPECT_FALSE(copy.is_populated());
+
+			// rank index is built once the last block is populated
+			EXPECT_EQ(expected.rank(sys_days{ p.get_until() }, true), ts.rank(sys_days{ p.get_until() }, true));
+			EXPECT_TRUE(ts.is_populated());
+			EXPECT_TRUE(ts.has_rank_index());
+
+			EXPECT_EQ(expected, ts);
+			EXPECT_EQ(expected, copy);
+
+			// and a copy of a fully populated one is not lazy (it shares all the pages and the rank index)
+			const auto populated = ts;
+			EXPECT_FALSE(populated.is_lazy());
+			EXPECT_TRUE(populated.is_populated());
+			EXPECT_TRUE(populated.has_rank_index());
+			EXPECT_EQ(ts.count_shared_pages(ts), populated.count_shared_pages(ts));
+			EXPECT_EQ(expected, populated);
+		}
+
+		TEST(time_series_bool, lazy_2)
+		{
+			// writes are not overwritten by the generator
+			const auto p = days_period{ 2000y / January / 1d, 2009y / December / 31d };
+			const auto is_set = [](const sys_days& sd) { return sd.time_since_epoch().count() % 3 == 0; };
+
+			auto ts = time_series<bool>{ p, is_set };
+			const auto d = sys_days{ 2005y / May / 5d };
+			ts[d] = !is_set(d);
+
+			auto expected = time_series<bool>{ p };
+			for (auto e = sys_days{ p.get_from() }; e <= sys_days{ p.get_until() }; e += days{ 1 })
+				expected[e] = is_set(e);
+			expected[d] = !is_set(d);
+
+			EXPECT_EQ(expected, ts);
+		}
+
+		TEST(time_series_bool, lazy_3)
+		{
+			// many readers at once, each starting from a different place (so they race for the same blocks)
+			const auto p = days_period{ 1950y / January / 1d, 2149y / December / 31d };
+			const auto f = sys_days{ p.get_from() };
+			const auto u = sys_days{ p.get_until() };
+
+			auto generated = std::atomic<std::size_t>{ 0uz };
+			const auto is_set = [&generated](const sys_days& sd) {
+				generated.fetch_add(1uz, std::memory_order_relaxed);
+				return sd.time_since_epoch().count() % 5 == 1;
+			};
+
+			auto expected = time_series<bool>{ p };
+			for (auto d = f; d <= u; d += days{ 1 })
+				expected[d] = is_set(d);
+			generated = 0uz;
+
+			const auto ts = time_series<bool>{ p, is_set };
+
+			auto mismatches = std::atomic<std::size_t>{ 0uz };
+			{
+				auto readers = std::vector<std::jthread>{};
+				for (auto t = 0; t != 8; ++t)
+					readers.emplace_back([&, t]() {
+						const auto size = (u - f).count() + 1;
+						for (auto i = 0; i != size; ++i)
+						{
+							const auto d = f + days{ (t * 9973 + i) % size };
+							const auto e = std::min(d + days{ 40 }, u);
+							if (ts[d] != expected[d] || ts.count(period{ d, e }) != expected.count(period{ d, e }) || ts.rank(d, true) != expected.rank(d, true))
+								mismatches.fetch_add(1uz);
+						}
+					});
+			}
+
+			EXPECT_EQ(0uz, mismatches.load());
+			EXPECT_TRUE(ts.is_populated());
+			EXPECT_TRUE(ts.has_rank_index());
+			EXPECT_EQ(static_cast<std::size_t>((u - f).count()) + 1uz, generated.load()); // each day only once
+		}
+
+		TEST(time_series_bool, lazy_4)
+		{
+			// rank and select only populate the blocks up to the one they need
+			const auto p = days_period{ 2000y / January / 1d, 2099y / December / 31d };
+			const auto f = sys_days{ p.get_from() };
+			const auto u = sys_days{ p.get_until() };
+
+			auto generated = std::atomic<std::size_t>{ 0uz };
+			const auto is_set = [&generated](const sys_days& sd) {
+				generated.fetch_add(1uz, std::memory_order_relaxed);
+				return sd.time_since_epoch().count() % 7 == 2;
+			};
+
+			auto expected = time_series<bool>{ p };
+			for (auto d = f; d <= u; d += days{ 1 })
+				expected[d] = is_set(d);
+			expected.build_rank_index();
+			generated = 0uz;
+
+			const auto ts = time_series<bool>{ p, is_set };
+			const auto d = sys_days{ 2010y / June / 1d };
+			EXPECT_EQ(expected.rank(d, true), ts.rank(d, true));
+			EXPECT_EQ(expected.rank(d, false), ts.rank(d, false));
+
+			const auto r = expected.rank(d, true);
+			EXPECT_EQ(expected.select(r, true), ts.select(r, true));
+			EXPECT_EQ(expected.select(r, false), ts.select(r, false));
+			EXPECT_FALSE(ts.is_populated());
+			EXPECT_LT(generated.load(), static_cast<std::size_t>((d - f).count()) + 400uz); // up to the end of the block with d
+
+			// the counts of the blocks are kept, also when days are written to (after the blocks they are in)
+			auto written = ts;
+			written[2050y / January / 1d] = !written[2050y / January / 1d];
+			auto written_expected = expected;
+			written_expected[2050y / January / 1d] = !written_expected[2050y / January / 1d];
+			for (const auto e : array{ f, d, sys_days{ 2049y / December / 31d }, sys_days{ 2050y / January / 2d }, u })
+			{
+				EXPECT_EQ(expected.rank(e, true), ts.rank(e, true));
+				EXPECT_EQ(written_expected.rank(e, true), written.rank(e, true));
+				EXPECT_EQ(written_expected.select(written_expected.rank(e, false), false), written.select(written.rank(e, false), false));
+			}
+
+			EXPECT_THROW(static_cast<void>(ts.select(expected.count(p), true)), out_of_range);
+			EXPECT_THROW(static_cast<void>(written.select(written_expected.count(p), true)), out_of_range);
+			EXPECT_TRUE(ts.is_populated());
+		}
+
+		TEST(time_series_bool, operator_bitwise_or_and_1)
+		{
+			// ts2 starts on a different day (so its words are not aligned with the ones of ts1)
+			const auto p1 = days_period{ 2020y / March / 3d, 2026y / October / 10d };
+			const auto p2 = days_period{ 2019y / December / 30d, 2027y / January / 1d };
+
+			auto ts1 = time_series<bool>{ p1 };
+			auto ts2 = time_series<bool>{ p2 };
+			for (auto d = sys_days{ p2.get_from() }; d <= sys_days{ p2.get_until() }; d += days{ 1 })
+			{
+				const auto n = d.time_since_epoch().count();
+				ts2[d] = n % 3 == 0;
+				if (p1.contains(year_month_day{ d }))
+					ts1[d] = n % 5 == 0;
+			}
+
+			auto ts_or = ts1;
+			ts_or |= ts2;
+			auto ts_and = ts1;
+			ts_and &= ts2;
+
+			// lazy series combine the same way
+			auto lazy = time_series<bool>{ p1, [](const sys_days& sd) { return sd.time_since_epoch().count() % 5 == 0; } };
+			lazy |= ts2;
+			EXPECT_EQ(ts_or, lazy);
+
+			auto expected_or = time_series<bool>{ p1 };
+			auto expected_and = time_series<bool>{ p1 };
+			for (auto d = sys_days{ p1.get_from() }; d <= sys_days{ p1.get_until() }; d += days{ 1 })
+			{
+				expected_or[d] = ts1[d] || ts2[d];
+				expected_and[d] = ts1[d] && ts2[d];
+			}
+
+			EXPECT_EQ(expected_or, ts_or);
+			EXPECT_EQ(expected_and, ts_and);
+
+			// padding stays clear, so counts over the whole period (with the rank index) are right
+			ts_or.build_rank_index();
+			EXPECT_EQ(expected_or.count(p1), ts_or.count(p1));
+
+			EXPECT_THROW(ts2 |= ts1, out_of_range);
 		}
 
 	}
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <unite_flat_sets.h>
+
+#include <gtest/gtest.h>
+
+#include <flat_set>
+#include <vector>
+#include <array>
+#include <span>
+
+using namespace std;
+
+
+namespace gregorian
+{
+
+	namespace util
+	{
+
+		TEST(unite_flat_sets, unite_flat_sets1)
+		{
+			const auto set1 = flat_set{ 1, 2 };
+			const auto set2 = flat_set{ 2, 3 };
+			const auto set3 = flat_set{ 3, 4 };
+
+			const auto expected1 = flat_set{ 1, 2, 3, 4 };
+			EXPECT_EQ(expected1, unite_flat_sets(set1, set3));
+
+			const auto expected2 = flat_set{ 1, 2, 3 };
+			EXPECT_EQ(expected2, unite_flat_sets(set1, set2));
+
+			const auto& expected3 = set1;
+			EXPECT_EQ(expected3, unite_flat_sets(set1, set1));
+			EXPECT_EQ(expected3, unite_flat_sets(set1, flat_set<int>{}));
+		}
+
+		TEST(unite_flat_sets, unite_flat_sets2)
+		{
+			const auto set1 = flat_set{ 1, 5, 9 };
+			const auto set2 = flat_set{ 2, 5, 10, 11 };
+			const auto set3 = flat_set<int>{};
+			const auto set4 = flat_set{ 0, 9, 12 };
+
+			const auto sets = array{ &set1, &set2, &set3, &set4, &set1 };
+
+			const auto expected1 = flat_set{ 0, 1, 2, 5, 9, 10, 11, 12 };
+			EXPECT_EQ(expected1, unite_flat_sets(span<const flat_set<int>* const>{ sets }));
+
+			EXPECT_EQ(set2, unite_flat_sets(span<const flat_set<int>* const>{ sets }.subspan(1, 2)));
+			EXPECT_EQ(flat_set<int>{}, unite_flat_sets(span<const flat_set<int>* const>{}));
+		}
+
+	}
+
+}